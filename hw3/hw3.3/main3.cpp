@@ -1,5 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <tuple>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <string>
 #include <stdexcept>
 
 class linkedMatrix {
@@ -7,11 +13,55 @@ private:
     int rows, cols;
     std::vector<std::tuple<int, int, int>> elements;
 
+    // 按行号计数排序，start[r]..start[r+1] 为第 r 行的三元组
+    static std::vector<std::tuple<int, int, int>> byRow(const std::vector<std::tuple<int, int, int>>& src,
+                                                       int n, std::vector<int>& start) {
+        start.assign(n + 1, 0);
+        for (auto& elem : src) ++start[std::get<0>(elem) + 1];
+        for (int r = 0; r < n; ++r) start[r + 1] += start[r];
+        std::vector<int> pos(start.begin(), start.end() - 1);
+        std::vector<std::tuple<int, int, int>> dst(src.size());
+        for (auto& elem : src) dst[pos[std::get<0>(elem)]++] = elem;
+        return dst;
+    }
+
+    // 计算结果的第 lo..hi-1 行，acc 为稠密累加器，touched 记录本行出现过的列
+    static void multiplyRows(const std::vector<std::tuple<int, int, int>>& aRows, const std::vector<int>& aStart,
+                             const std::vector<std::tuple<int, int, int>>& bRows, const std::vector<int>& bStart,
+                             int outCols, int lo, int hi, std::vector<std::tuple<int, int, int>>& out) {
+        std::vector<int> acc(outCols, 0);
+        std::vector<char> seen(outCols, 0);
+        std::vector<int> touched;
+        for (int i = lo; i < hi; ++i) {
+            for (int p = aStart[i]; p < aStart[i + 1]; ++p) {
+                int k = std::get<1>(aRows[p]);
+                int a = std::get<2>(aRows[p]);
+                for (int q = bStart[k]; q < bStart[k + 1]; ++q) {
+                    int j = std::get<1>(bRows[q]);
+                    if (!seen[j]) {
+                        seen[j] = 1;
+                        touched.push_back(j);
+                    }
+                    acc[j] += a * std::get<2>(bRows[q]);
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (int j : touched) {
+                if (acc[j] != 0) out.push_back(std::make_tuple(i, j, acc[j]));
+                acc[j] = 0;
+                seen[j] = 0;
+            }
+            touched.clear();
+        }
+    }
+
 public:
     linkedMatrix(int r, int c) : rows(r), cols(c) {}
 
     // 插入元素
     void insert(int row, int col, int val) {
+        if (row < 0 || row >= rows || col < 0 || col >= cols)
+            throw std::out_of_range("Matrix index out of range");
         if (val == 0) return; // 不存储值为0的元素
         elements.push_back(std::make_tuple(row, col, val));
     }
@@ -70,8 +120,8 @@ public:
         return result;
     }
 
-    // 矩阵乘法
-    linkedMatrix multiply(const linkedMatrix& other) {
+    // 矩阵乘法（逐对插入部分积，结果中同一坐标可能出现多次，仅保留作对照）
+    linkedMatrix multiplyNaive(const linkedMatrix& other) {
         if (cols != other.rows) {
             throw std::invalid_argument("Matrix dimensions do not match for multiplication");
         }
@@ -86,6 +136,47 @@ public:
         return result;
     }
 
+    // 矩阵乘法：按行累加部分积，每个输出坐标只产生一个三元组
+    // threads > 1 时把 A 的行区间分给多个线程，各自累加后按行序拼接
+    linkedMatrix multiply(const linkedMatrix& other, int threads = 1) {
+        if (cols != other.rows) {
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+        }
+        std::vector<int> aStart, bStart;
+        std::vector<std::tuple<int, int, int>> aRows = byRow(elements, rows, aStart);
+        std::vector<std::tuple<int, int, int>> bRows = byRow(other.elements, other.rows, bStart);
+
+        if (threads < 1) threads = 1;
+        if (threads > rows) threads = rows > 0 ? rows : 1;
+        std::vector<std::vector<std::tuple<int, int, int>>> parts(threads);
+        auto work = [&](int t) {
+            int lo = (int)((long long)rows * t / threads);
+            int hi = (int)((long long)rows * (t + 1) / threads);
+            multiplyRows(aRows, aStart, bRows, bStart, other.cols, lo, hi, parts[t]);
+        };
+        if (threads == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> pool;
+            for (int t = 0; t < threads; ++t) pool.emplace_back(work, t);
+            for (auto& th : pool) th.join();
+        }
+
+        linkedMatrix result(rows, other.cols);
+        size_t total = 0;
+        for (auto& part : parts) total += part.size();
+        result.elements.reserve(total);
+        for (auto& part : parts) {
+            result.elements.insert(result.elements.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+
+    // 三元组个数
+    size_t size() const {
+        return elements.size();
+    }
+
     // 打印矩阵
     void print() {
         std::cout << "(" << rows << ", " << cols << ", triples=[";
@@ -97,8 +188,52 @@ public:
     }
 };
 
+// 随机稀疏矩阵，每个坐标至多一个非零元
+linkedMatrix randomMatrix(int n, int nnz, std::mt19937& gen) {
+    linkedMatrix m(n, n);
+    std::uniform_int_distribution<int> idx(0, n - 1), val(1, 9);
+    std::vector<long long> keys;
+    keys.reserve(nnz);
+    while ((int)keys.size() < nnz) {
+        keys.push_back((long long)idx(gen) * n + idx(gen));
+        if ((int)keys.size() == nnz) {
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+    }
+    for (long long key : keys) m.insert((int)(key / n), (int)(key % n), val(gen));
+    return m;
+}
+
+// 乘法基准：main3 bench [nnz] [threads]
+void benchmark(int nnz, int threads) {
+    const int n = 100000;
+    std::mt19937 gen(12345);
+    linkedMatrix A = randomMatrix(n, nnz, gen);
+    linkedMatrix B = randomMatrix(n, nnz, gen);
+
+    auto run = [](const char* name, auto f) {
+        auto t0 = std::chrono::steady_clock::now();
+        linkedMatrix C = f();
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << name << ": triples=" << C.size() << ", time="
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    };
+    std::cout << n << "x" << n << ", nnz=" << nnz << std::endl;
+    run("naive", [&] { return A.multiplyNaive(B); });
+    run("accumulate", [&] { return A.multiply(B); });
+    run("accumulate (parallel)", [&] { return A.multiply(B, threads); });
+}
+
 // 测试用例
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        int nnz = argc > 2 ? std::stoi(argv[2]) : 20000;
+        int threads = argc > 3 ? std::stoi(argv[3]) : (int)std::max(1u, std::thread::hardware_concurrency());
+        benchmark(nnz, threads);
+        return 0;
+    }
+
     linkedMatrix A(3, 3);
     A.insert(0, 2, 7);
     A.insert(1, 1, 5);
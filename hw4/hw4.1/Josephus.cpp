@@ -1,6 +1,12 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <stdexcept>
 using namespace std;
 
 // Function to solve Josephus problem using an array
@@ -63,17 +69,387 @@ void josephusList(int n, int m) {
     delete current;
 }
 
-int main() {
-    int n, m;
+// Buffered writer for long elimination sequences
+class BufferedWriter {
+public:
+    explicit BufferedWriter(FILE* out) : out(out), len(0) {}
+    ~BufferedWriter() { flush(); }
+
+    void write(long long x) {
+        if (len + 24 > SIZE) flush();
+        char tmp[24];
+        int k = 0;
+        unsigned long long v = x < 0 ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+        do {
+            tmp[k++] = char('0' + v % 10);
+            v /= 10;
+        } while (v);
+        if (x < 0) buf[len++] = '-';
+        while (k) buf[len++] = tmp[--k];
+    }
+
+    void put(char c) {
+        if (len == SIZE) flush();
+        buf[len++] = c;
+    }
+
+    void flush() {
+        fwrite(buf, 1, len, out);
+        len = 0;
+        fflush(out);
+    }
+
+private:
+    static const size_t SIZE = 1 << 16;
+    FILE* out;
+    size_t len;
+    char buf[SIZE];
+};
+
+// Order-statistic set over 1..n backed by a Fenwick tree
+class FenwickOrderSet {
+public:
+    explicit FenwickOrderSet(int n) : n(n), tree(n + 1, 0) {
+        // O(n) build: every position starts present
+        for (int i = 1; i <= n; ++i) {
+            tree[i] += 1;
+            int parent = i + (i & -i);
+            if (parent <= n) tree[parent] += tree[i];
+        }
+        step = 1;
+        while (step * 2 <= n) step *= 2;
+    }
+
+    void erase(int pos) {
+        for (; pos <= n; pos += pos & -pos) --tree[pos];
+    }
+
+    // number of present positions in 1..pos
+    int rank(int pos) const {
+        int sum = 0;
+        for (; pos > 0; pos -= pos & -pos) sum += tree[pos];
+        return sum;
+    }
+
+    // k-th present position (1-based) by binary lifting
+    int kth(int k) const {
+        int pos = 0;
+        for (int s = step; s > 0; s >>= 1) {
+            if (pos + s <= n && tree[pos + s] < k) {
+                pos += s;
+                k -= tree[pos];
+            }
+        }
+        return pos + 1;
+    }
+
+private:
+    int n;
+    int step;
+    vector<int> tree;
+};
+
+// Function to solve Josephus problem in O(n log n) using a Fenwick tree
+void josephusFenwick(int n, long long m, FILE* out = stdout) {
+    BufferedWriter writer(out);
+    if (n <= 0 || m <= 0) {
+        for (const char* p = "WRONG\n"; *p; ++p) writer.put(*p);
+        return;
+    }
+
+    FenwickOrderSet alive(n);
+    int index = 0;
+    for (int remaining = n; remaining > 1; --remaining) {
+        index = (int)((index + (m - 1) % remaining) % remaining);
+        int person = alive.kth(index + 1);
+        writer.write(person);
+        writer.put(' ');
+        alive.erase(person);
+    }
+    writer.write(alive.kth(1));
+    writer.put('\n');
+}
+
+// Function to solve Josephus problem using a linked list stored in one index array:
+// next[i] is the successor of person i + 1, so no node is allocated or freed per step
+void josephusPooledList(int n, long long m, FILE* out = stdout) {
+    BufferedWriter writer(out);
+    if (n <= 0 || m <= 0) {
+        for (const char* p = "WRONG\n"; *p; ++p) writer.put(*p);
+        return;
+    }
+
+    vector<int> next(n);
+    for (int i = 0; i < n; ++i) {
+        next[i] = i + 1 == n ? 0 : i + 1;
+    }
+
+    int prev = n - 1;
+    for (int remaining = n; remaining > 1; --remaining) {
+        // never walk the ring more than once
+        long long hops = (m - 1) % remaining;
+        for (long long i = 0; i < hops; ++i) {
+            prev = next[prev];
+        }
+        int current = next[prev];
+        next[prev] = next[current];
+        writer.write(current + 1);
+        writer.put(' ');
+    }
+    writer.write(prev + 1);
+    writer.put('\n');
+}
+
+// Josephus game with a step size per round (steps are reused cyclically).
+// Rounds are played on demand, each in O(log n); played rounds and the
+// current position of any survivor are answered without replaying the game.
+class JosephusEngine {
+public:
+    JosephusEngine(int n, const vector<long long>& steps)
+        : n(n), steps(steps), alive(n > 0 ? n : 0), index(0), remaining(n > 0 ? n : 0),
+          roundOf(n > 0 ? n + 1 : 1, -1) {
+        if (n <= 0 || steps.empty()) {
+            throw invalid_argument("JosephusEngine: need n > 0 and at least one step");
+        }
+        for (long long m : steps) {
+            if (m <= 0) throw invalid_argument("JosephusEngine: step sizes must be positive");
+        }
+        order.reserve(n);
+    }
+
+    // number of rounds played so far; the last person standing counts as round n - 1
+    int played() const {
+        return (int)order.size();
+    }
+
+    bool finished() const {
+        return played() == n;
+    }
+
+    // play up to `rounds` more rounds, returns how many were played
+    int advance(int rounds = 1) {
+        int done = 0;
+        while (done < rounds && !finished()) {
+            int person;
+            if (remaining == 1) {
+                person = alive.kth(1);
+            } else {
+                long long m = steps[order.size() % steps.size()];
+                index = (int)((index + (m - 1) % remaining) % remaining);
+                person = alive.kth(index + 1);
+            }
+            alive.erase(person);
+            --remaining;
+            if (remaining > 0) index %= remaining;
+            roundOf[person] = played();
+            order.push_back(person);
+            ++done;
+        }
+        return done;
+    }
+
+    // person eliminated at round r (0-based), playing forward if needed
+    int eliminatedAt(int r) {
+        if (r < 0 || r >= n) throw out_of_range("JosephusEngine::eliminatedAt(): no such round");
+        if (r >= played()) advance(r + 1 - played());
+        return order[r];
+    }
+
+    // round in which person p was eliminated, -1 while still in the circle
+    int eliminationRound(int p) const {
+        if (p < 1 || p > n) throw out_of_range("JosephusEngine::eliminationRound(): no such person");
+        return roundOf[p];
+    }
+
+    // 0-based distance of survivor p from where the next count starts, -1 if eliminated
+    int positionOf(int p) const {
+        if (eliminationRound(p) >= 0) return -1;
+        int r = alive.rank(p) - 1;
+        return (r - index + remaining) % remaining;
+    }
+
+    int survivors() const {
+        return remaining;
+    }
+
+private:
+    int n;
+    vector<long long> steps;
+    FenwickOrderSet alive;
+    int index;            // rank (0-based) of the person the next count starts from
+    int remaining;
+    vector<int> order;    // order[r]: person eliminated at round r
+    vector<int> roundOf;  // roundOf[p]: round of person p, -1 if alive
+};
+
+// Survivor only, O(n) recurrence: J(1) = 0, J(k) = (J(k-1) + m) mod k
+long long survivorRecurrence(long long n, long long m) {
+    long long pos = 0;
+    for (long long k = 2; k <= n; ++k) {
+        pos = (pos + m % k) % k;
+    }
+    return pos + 1;
+}
+
+// Survivor only, O(m log n): one pass around the ring removes n/m people at once.
+// Once the ring is smaller than m the recurrence finishes it. The ring sizes on the
+// way down are replayed from a checkpoint every JUMP_BLOCK steps instead of being
+// stored, so memory stays O(steps / JUMP_BLOCK + JUMP_BLOCK).
+const int JUMP_BLOCK = 4096;
+
+long long survivorJump(long long n, long long m) {
+    if (m == 1) return n;
+    auto next = [m](long long k) { return k - k / m; };
+    vector<long long> checkpoints;
+    long long k = n;
+    for (long long step = 0; k > 1 && k >= m; ++step, k = next(k)) {
+        if (step % JUMP_BLOCK == 0) checkpoints.push_back(k);
+    }
+    long long pos = survivorRecurrence(k, m) - 1;
+
+    vector<long long> sizes;
+    sizes.reserve(JUMP_BLOCK);
+    while (!checkpoints.empty()) {
+        sizes.clear();
+        for (k = checkpoints.back(); k > 1 && k >= m && (int)sizes.size() < JUMP_BLOCK; k = next(k)) {
+            sizes.push_back(k);
+        }
+        checkpoints.pop_back();
+        // rebuild the answer upwards through this block
+        while (!sizes.empty()) {
+            k = sizes.back();
+            sizes.pop_back();
+            pos -= k % m;
+            if (pos < 0) pos += k;
+            else pos += pos / (m - 1);
+        }
+    }
+    return pos + 1;
+}
+
+// Survivor only, choosing the cheaper of the two methods
+long long josephusSurvivor(long long n, long long m) {
+    if (n <= 0 || m <= 0) return -1;
+    if (m >= n) return survivorRecurrence(n, m);
+    if (m < n / 64) return survivorJump(n, m);
+    return n <= 100000000 ? survivorRecurrence(n, m) : survivorJump(n, m);
+}
+
+// Answer every "n m" pair in the stream, one survivor per line
+void survivorBatch(istream& in, FILE* out = stdout) {
+    BufferedWriter writer(out);
+    long long n, m;
+    while (in >> n >> m) {
+        long long s = josephusSurvivor(n, m);
+        if (s < 0) {
+            for (const char* p = "WRONG"; *p; ++p) writer.put(*p);
+        } else {
+            writer.write(s);
+        }
+        writer.put('\n');
+    }
+}
+
+// Time every method on one (n, m); simulators are skipped when too slow
+void benchmark(int n, long long m) {
+    auto run = [](const char* name, auto f) {
+        auto t0 = chrono::steady_clock::now();
+        f();
+        auto t1 = chrono::steady_clock::now();
+        cout << name << ": " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+    };
+    cout << "n=" << n << ", m=" << m << endl;
+
+    ostringstream sink;
+    streambuf* saved = cout.rdbuf();
+    FILE* null = fopen("/dev/null", "w");
+    long long survivor = 0;
+    if ((long long)n * n <= 10000000000LL && (long long)n * m <= 10000000000LL) {
+        cout.rdbuf(sink.rdbuf());
+        auto t0 = chrono::steady_clock::now();
+        josephusArray(n, (int)m);
+        auto t1 = chrono::steady_clock::now();
+        josephusList(n, (int)m);
+        auto t2 = chrono::steady_clock::now();
+        cout.rdbuf(saved);
+        cout << "array: " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+        cout << "list: " << chrono::duration<double, milli>(t2 - t1).count() << " ms" << endl;
+    }
+    if (null) {
+        if ((long long)n * (m < n ? m : n) <= 10000000000LL) {
+            run("pooled list", [&] { josephusPooledList(n, m, null); });
+        }
+        run("fenwick", [&] { josephusFenwick(n, m, null); });
+        fclose(null);
+    }
+    run("recurrence", [&] { survivor = survivorRecurrence(n, m); });
+    cout << "  survivor " << survivor << endl;
+    run("jump", [&] { survivor = survivorJump(n, m); });
+    cout << "  survivor " << survivor << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        int n = argc > 2 ? stoi(argv[2]) : 100000;
+        long long m = argc > 3 ? stoll(argv[3]) : 3;
+        benchmark(n, m);
+        return 0;
+    }
+
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "survivor") {
+        // every "n m" pair of the file is a separate query
+        ifstream queries(argc > 2 ? argv[2] : "input.txt");
+        if (!queries.is_open()) {
+            cout << "File cannot be opened" << endl;
+            return 1;
+        }
+        survivorBatch(queries);
+        return 0;
+    }
+
+    if (mode == "steps") {
+        // input.txt: n followed by the step sizes of successive rounds
+        ifstream steps("input.txt");
+        if (!steps.is_open()) {
+            cout << "File cannot be opened" << endl;
+            return 1;
+        }
+        int n;
+        vector<long long> seq;
+        long long m;
+        steps >> n;
+        while (steps >> m) seq.push_back(m);
+        try {
+            JosephusEngine game(n, seq);
+            BufferedWriter writer(stdout);
+            for (int r = 0; r < n; ++r) {
+                writer.write(game.eliminatedAt(r));
+                writer.put(r + 1 < n ? ' ' : '\n');
+            }
+        } catch (const exception&) {
+            cout << "WRONG" << endl;
+        }
+        return 0;
+    }
+
+    int n;
+    long long m;
     ifstream infile("input.txt");
     if (infile.is_open()) {
         infile >> n >> m;
         infile.close();
 
-        josephusArray(n, m);
-        cout << endl;
-        josephusList(n, m);
-        cout << endl;
+        if (mode == "fenwick") {
+            josephusFenwick(n, m);
+        } else if (mode == "pooled") {
+            josephusPooledList(n, m);
+        } else {
+            josephusArray(n, (int)m);
+            cout << endl;
+            josephusList(n, (int)m);
+            cout << endl;
+        }
     } else {
         cout << "File cannot be opened" << endl;
     }
@@ -1,87 +1,632 @@
 #include <iostream>
-#include <stack>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+#include <initializer_list>
+#include <cstdio>
+#include <cctype>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 using namespace std;
 
-template <class T>
+// Stack over contiguous storage; data()[0] is the bottom, data()[size() - 1] the top.
+// The first N elements live inside the object, so small stacks never touch the heap.
+template <class T, size_t N = 16>
 class Stack {
+    static_assert(N > 0, "Stack: N must be at least 1");
+
 public:
+    Stack() : first(inlineData()), count(0), cap(N) {}
+
+    Stack(const Stack& other) : Stack() {
+        reserve(other.count);
+        for (size_t i = 0; i < other.count; ++i) {
+            new (first + i) T(other.first[i]);
+            ++count;
+        }
+    }
+
+    Stack(Stack&& other) noexcept(is_nothrow_move_constructible<T>::value) : Stack() {
+        steal(other);
+    }
+
+    Stack& operator=(Stack other) {
+        clear();
+        release();
+        steal(other);
+        return *this;
+    }
+
+    ~Stack() {
+        clear();
+        release();
+    }
+
     void push(const T& value) {
-        elements.push(value);
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    template <class... Args>
+    T& emplace(Args&&... args) {
+        if (count == cap) {
+            // construct first: args may refer to an element about to move
+            T value(std::forward<Args>(args)...);
+            grow(cap * 2);
+            new (first + count) T(std::move(value));
+        } else {
+            new (first + count) T(std::forward<Args>(args)...);
+        }
+        return first[count++];
     }
 
     void pop() {
-        if (!elements.empty()) {
-            elements.pop();
+        if (count > 0) {
+            first[--count].~T();
         }
     }
 
-    T top() const {
-        if (!elements.empty()) {
-            return elements.top();
+    T& top() {
+        if (count > 0) {
+            return first[count - 1];
+        }
+        throw out_of_range("Stack<>::top(): empty stack");
+    }
+
+    const T& top() const {
+        if (count > 0) {
+            return first[count - 1];
         }
         throw out_of_range("Stack<>::top(): empty stack");
     }
 
     bool empty() const {
-        return elements.empty();
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    size_t capacity() const {
+        return cap;
+    }
+
+    void reserve(size_t n) {
+        if (n > cap) grow(n);
+    }
+
+    T* data() {
+        return first;
+    }
+
+    const T* data() const {
+        return first;
+    }
+
+    // drop everything above the first n elements
+    void truncate(size_t n) {
+        while (count > n) {
+            first[--count].~T();
+        }
+    }
+
+    void clear() {
+        truncate(0);
+    }
+
+private:
+    T* inlineData() {
+        return reinterpret_cast<T*>(buffer);
+    }
+
+    // strong guarantee: if a copy throws, the new block is undone and the old one is untouched
+    void grow(size_t n) {
+        T* fresh = static_cast<T*>(::operator new(n * sizeof(T)));
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                new (fresh + built) T(std::move_if_noexcept(first[built]));
+            }
+        } catch (...) {
+            while (built > 0) fresh[--built].~T();
+            ::operator delete(fresh);
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            first[i].~T();
+        }
+        release();
+        first = fresh;
+        cap = n;
+    }
+
+    void release() {
+        if (first != inlineData()) {
+            ::operator delete(first);
+            first = inlineData();
+            cap = N;
+        }
+    }
+
+    // take other's elements; this must be empty and inline
+    void steal(Stack& other) {
+        if (other.first != other.inlineData()) {
+            first = other.first;
+            cap = other.cap;
+            count = other.count;
+            other.first = other.inlineData();
+            other.cap = N;
+            other.count = 0;
+        } else {
+            for (size_t i = 0; i < other.count; ++i) {
+                new (first + i) T(std::move(other.first[i]));
+            }
+            count = other.count;
+            other.clear();
+        }
+    }
+
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+    T* first;
+    size_t count;
+    size_t cap;
+};
+
+// 256-bit membership table for byte-sized values
+class ByteSet {
+public:
+    ByteSet() : bits{0, 0, 0, 0} {}
+
+    void insert(unsigned char c) {
+        bits[c >> 6] |= uint64_t(1) << (c & 63);
+    }
+
+    bool contains(unsigned char c) const {
+        return (bits[c >> 6] >> (c & 63)) & 1;
     }
 
 private:
-    stack<T> elements;
+    uint64_t bits[4];
 };
 
+// Remove every element equal to any value in [first, last) in one pass
+template <class T, size_t N, class Iter>
+void delete_all(Stack<T, N> &s, Iter first, Iter last) {
+    if constexpr (sizeof(T) == 1 && is_integral<T>::value) {
+        ByteSet targets;
+        for (; first != last; ++first) targets.insert((unsigned char)*first);
+        erase_if(s, [&targets](T value) { return targets.contains((unsigned char)value); });
+    } else {
+        unordered_set<T> targets(first, last);
+        erase_if(s, [&targets](const T& value) { return targets.count(value) != 0; });
+    }
+}
+
+template <class T, size_t N>
+void delete_all(Stack<T, N> &s, initializer_list<T> values) {
+    delete_all(s, values.begin(), values.end());
+}
+
+// Lock-free stack for sharing work between threads (Treiber stack).
+// Nodes live in chunks that are never freed and are addressed by 32-bit
+// index; the head word packs that index with a 32-bit version tag, so a
+// node popped and pushed again between a load and a CAS cannot be
+// mistaken for the old one (ABA). When the head CAS fails, push and pop
+// meet in an elimination array and exchange the value without touching
+// the head at all.
 template <class T>
-void delete_all(Stack<T> &s, const T &x) {
-    vector<T> temp;
-    while (!s.empty()) {
-        T value = s.top();
-        s.pop();
-        if (value != x) {
-            temp.push_back(value);
+class ConcurrentStack {
+public:
+    ConcurrentStack()
+        : head(pack(NIL, 0)), freeList(pack(NIL, 0)), fresh(0), chunks(new atomic<Node*>[MAX_CHUNKS]) {
+        for (uint32_t i = 0; i < MAX_CHUNKS; ++i) chunks[i].store(nullptr, memory_order_relaxed);
+        for (auto& slot : exchanger) slot.store(EMPTY, memory_order_relaxed);
+    }
+
+    ~ConcurrentStack() {
+        for (uint32_t i = 0; i < MAX_CHUNKS; ++i) delete[] chunks[i].load(memory_order_relaxed);
+        delete[] chunks;
+    }
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    void push(const T& value) {
+        uint32_t idx = allocate();
+        node(idx).value = value;
+        if (!tryPush(head, idx)) {
+            for (unsigned attempt = 1;; ++attempt) {
+                if (offer(idx)) return;
+                if (tryPush(head, idx)) return;
+                backoff(attempt);
+            }
         }
     }
 
-    while (!temp.empty()) {
-        s.push(temp.back());
-        temp.pop_back();
+    bool pop(T& out) {
+        uint32_t idx;
+        int result = tryPop(head, idx);
+        for (unsigned attempt = 1; result < 0; ++attempt) {
+            if (take(idx)) {
+                result = 1;
+                break;
+            }
+            result = tryPop(head, idx);
+            if (result < 0) backoff(attempt);
+        }
+        if (result == 0) return false;
+        out = std::move(node(idx).value);
+        release(idx);
+        return true;
     }
-}
 
-int main() {
-    ifstream infile("input.txt");
-    if (!infile.is_open()) {
-        cout << "File cannot be opened" << endl;
-        return 1;
+    bool empty() const {
+        return index(head.load(memory_order_acquire)) == NIL;
     }
 
-    char x;
-    infile >> x;
-    infile.ignore(); // Ignore the newline character
+private:
+    struct Node {
+        T value;
+        atomic<uint32_t> next;
+    };
+
+    static const uint32_t NIL = 0xFFFFFFFFu;
+    static const uint32_t CHUNK_BITS = 12;
+    static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static const uint32_t MAX_CHUNKS = 1u << 16;
+    static const size_t SLOTS = 8;
+    static const uint64_t EMPTY = 0;
+    static const uint64_t TAKEN = 1;
 
-    Stack<char> s;
-    char ch;
-    while (infile >> ch) {
-        s.push(ch);
-        infile.ignore(); // Ignore the space, newline or tab character
+    static uint64_t pack(uint32_t idx, uint32_t tag) {
+        return (uint64_t)tag << 32 | idx;
+    }
+
+    static uint32_t index(uint64_t word) {
+        return (uint32_t)word;
+    }
+
+    static uint32_t tag(uint64_t word) {
+        return (uint32_t)(word >> 32);
+    }
+
+    Node& node(uint32_t idx) {
+        return chunks[idx >> CHUNK_BITS].load(memory_order_acquire)[idx & (CHUNK_SIZE - 1)];
+    }
+
+    // one attempt at linking idx in front of the list rooted at top
+    bool tryPush(atomic<uint64_t>& top, uint32_t idx) {
+        uint64_t old = top.load(memory_order_relaxed);
+        node(idx).next.store(index(old), memory_order_relaxed);
+        return top.compare_exchange_weak(old, pack(idx, tag(old) + 1),
+                                         memory_order_release, memory_order_relaxed);
+    }
+
+    // one attempt at unlinking the front node: 1 popped, 0 empty, -1 contended
+    int tryPop(atomic<uint64_t>& top, uint32_t& idx) {
+        uint64_t old = top.load(memory_order_acquire);
+        idx = index(old);
+        if (idx == NIL) return 0;
+        uint32_t next = node(idx).next.load(memory_order_relaxed);
+        return top.compare_exchange_weak(old, pack(next, tag(old) + 1),
+                                         memory_order_acquire, memory_order_relaxed) ? 1 : -1;
+    }
+
+    uint32_t allocate() {
+        uint32_t idx;
+        for (;;) {
+            int result = tryPop(freeList, idx);
+            if (result == 1) return idx;
+            if (result == 0) break;
+        }
+        idx = fresh.fetch_add(1, memory_order_relaxed);
+        if (idx / CHUNK_SIZE >= MAX_CHUNKS) throw length_error("ConcurrentStack: too many nodes");
+        atomic<Node*>& chunk = chunks[idx >> CHUNK_BITS];
+        if (!chunk.load(memory_order_acquire)) {
+            Node* block = new Node[CHUNK_SIZE];
+            Node* expected = nullptr;
+            if (!chunk.compare_exchange_strong(expected, block, memory_order_acq_rel)) delete[] block;
+        }
+        return idx;
+    }
+
+    void release(uint32_t idx) {
+        while (!tryPush(freeList, idx)) {
+        }
+    }
+
+    atomic<uint64_t>& slotFor(unsigned salt) {
+        static thread_local unsigned seed = (unsigned)hash<thread::id>()(this_thread::get_id());
+        seed = seed * 1103515245u + 12345u + salt;
+        return exchanger[(seed >> 16) % SLOTS];
+    }
+
+    // hand idx to a concurrent pop through the elimination array
+    bool offer(uint32_t idx) {
+        atomic<uint64_t>& slot = slotFor(idx);
+        uint64_t expected = EMPTY;
+        uint64_t mine = (uint64_t)idx + 2;
+        if (!slot.compare_exchange_strong(expected, mine, memory_order_release, memory_order_relaxed)) {
+            return false;
+        }
+        for (int spin = 0; spin < 64; ++spin) {
+            if (slot.load(memory_order_acquire) == TAKEN) break;
+        }
+        // withdraw; if that fails a pop has taken the node
+        if (slot.compare_exchange_strong(mine, EMPTY, memory_order_relaxed)) return false;
+        slot.store(EMPTY, memory_order_release);
+        return true;
+    }
+
+    // take a node offered by a concurrent push
+    bool take(uint32_t& idx) {
+        atomic<uint64_t>& slot = slotFor(0);
+        uint64_t seen = slot.load(memory_order_acquire);
+        if (seen == EMPTY || seen == TAKEN) return false;
+        if (!slot.compare_exchange_strong(seen, TAKEN, memory_order_acquire, memory_order_relaxed)) return false;
+        idx = (uint32_t)(seen - 2);
+        return true;
+    }
+
+    static void backoff(unsigned attempt) {
+        if (attempt > 16) this_thread::yield();
+    }
+
+    atomic<uint64_t> head;
+    atomic<uint64_t> freeList;
+    atomic<uint32_t> fresh;
+    atomic<Node*>* chunks;  // MAX_CHUNKS entries, on the heap so a local stack stays small
+    atomic<uint64_t> exchanger[SLOTS];
+};
+
+// Stack<T> behind one mutex, the baseline for the benchmark
+template <class T>
+class LockedStack {
+public:
+    void push(const T& value) {
+        lock_guard<mutex> guard(lock);
+        elements.push(value);
+    }
+
+    bool pop(T& out) {
+        lock_guard<mutex> guard(lock);
+        if (elements.empty()) return false;
+        out = std::move(elements.top());
+        elements.pop();
+        return true;
+    }
+
+private:
+    mutex lock;
+    Stack<T> elements;
+};
+
+// Every thread alternates push and pop; returns millions of operations per second
+template <class S>
+double stackThroughput(int threads, long long opsPerThread) {
+    S stack;
+    atomic<bool> go(false);
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            while (!go.load(memory_order_acquire)) {
+            }
+            long long value;
+            for (long long i = 0; i < opsPerThread; i += 2) {
+                stack.push(i * threads + t);
+                stack.pop(value);
+            }
+        });
+    }
+    auto t0 = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto& th : pool) th.join();
+    auto t1 = chrono::steady_clock::now();
+    return threads * opsPerThread / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+void benchmark(int maxThreads, long long opsPerThread) {
+    cout << "threads  lock-free(Mops/s)  mutex(Mops/s)" << endl;
+    for (int t = 1;; t = min(t * 2, maxThreads)) {
+        double lockFree = stackThroughput<ConcurrentStack<long long>>(t, opsPerThread);
+        double locked = stackThroughput<LockedStack<long long>>(t, opsPerThread);
+        cout << t << "  " << lockFree << "  " << locked << endl;
+        if (t == maxThreads) break;
     }
+}
 
-    delete_all(s, x);
+// Stable in-place removal of every byte equal to x, returns the new length.
+// Blocks of 16 bytes with no match are moved (or skipped) whole.
+inline size_t remove_byte(unsigned char* p, size_t n, unsigned char x) {
+    size_t out = 0, i = 0;
+#ifdef __SSE2__
+    const __m128i needle = _mm_set1_epi8((char)x);
+    for (; i + 16 <= n; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(p + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask == 0) {
+            if (out != i) _mm_storeu_si128((__m128i*)(p + out), block);
+            out += 16;
+        } else if (mask != 0xFFFF) {
+            for (int k = 0; k < 16; ++k) {
+                if (!(mask & (1u << k))) p[out++] = p[i + k];
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i] != x) p[out++] = p[i];
+    }
+    return out;
+}
+
+// Remove every element satisfying pred, keeping the order of the rest
+template <class T, size_t N, class Pred>
+void erase_if(Stack<T, N> &s, Pred pred) {
+    T* first = s.data();
+    T* last = remove_if(first, first + s.size(), pred);
+    s.truncate(last - first);
+}
 
-    if (s.empty()) {
-        cout << endl << endl; // 输出两个换行符
+template <class T, size_t N>
+void delete_all(Stack<T, N> &s, const T &x) {
+    if constexpr (sizeof(T) == 1 && is_trivially_copyable<T>::value && is_integral<T>::value) {
+        unsigned char needle;
+        memcpy(&needle, &x, 1);
+        s.truncate(remove_byte(reinterpret_cast<unsigned char*>(s.data()), s.size(), needle));
     } else {
-        while (!s.empty()) {
-            cout << s.top();
-            s.pop();
-            if (!s.empty()) {
-                cout << " ";
+        erase_if(s, [&x](const T& value) { return value == x; });
+    }
+}
+
+// Read-only view of a whole file: mmap where available, otherwise read into memory
+class MappedFile {
+public:
+    explicit MappedFile(const char* path) : first(nullptr), length(0), mapped(false), opened(false) {
+#ifdef HAVE_MMAP
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+                first = static_cast<const char*>(p);
+                length = (size_t)st.st_size;
+                mapped = true;
             }
         }
-        cout << endl << endl; // 输出两个换行符
+        close(fd);
+        if (mapped) {
+            opened = true;
+            return;
+        }
+#endif
+        FILE* f = fopen(path, "rb");
+        if (!f) return;
+        char chunk[1 << 16];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            copy.insert(copy.end(), chunk, chunk + got);
+        }
+        fclose(f);
+        first = copy.data();
+        length = copy.size();
+        opened = true;
+    }
+
+    ~MappedFile() {
+#ifdef HAVE_MMAP
+        if (mapped) munmap(const_cast<char*>(first), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const {
+        return opened;
+    }
+
+    const char* data() const {
+        return first;
     }
 
+    size_t size() const {
+        return length;
+    }
+
+private:
+    const char* first;
+    size_t length;
+    bool mapped;
+    bool opened;
+    vector<char> copy;
+};
+
+// Same tokens as "infile >> ch; infile.ignore();": skip whitespace, take one
+// char, drop the char after it. The first token is the symbol to delete; the
+// rest are pushed onto s except copies of that symbol. Returns false if the
+// file has no symbol at all.
+bool read_filtered(const MappedFile& in, Stack<char>& s) {
+    const char* p = in.data();
+    const char* end = p + in.size();
+    auto next = [&](char& out) {
+        while (p < end && isspace((unsigned char)*p)) ++p;
+        if (p == end) return false;
+        out = *p++;
+        if (p < end) ++p;
+        return true;
+    };
+
+    char x, ch;
+    if (!next(x)) return false;
+    s.reserve(in.size() / 2);
+    while (next(ch)) {
+        if (ch != x) s.push(ch);
+    }
+    return true;
+}
+
+// Print s from top to bottom separated by spaces, then two newlines
+void write_reversed(const Stack<char>& s, FILE* out) {
+    char buf[1 << 16];
+    size_t len = 0;
+    const char* base = s.data();
+    for (size_t i = s.size(); i-- > 0;) {
+        if (len + 2 > sizeof(buf)) {
+            fwrite(buf, 1, len, out);
+            len = 0;
+        }
+        buf[len++] = base[i];
+        if (i > 0) buf[len++] = ' ';
+    }
+    fwrite(buf, 1, len, out);
+    fputs("\n\n", out); // 输出两个换行符
+    fflush(out);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        int threads = argc > 2 ? max(1, stoi(argv[2])) : (int)max(1u, thread::hardware_concurrency());
+        long long ops = argc > 3 ? stoll(argv[3]) : 1000000;
+        benchmark(threads, ops);
+        return 0;
+    }
+
+    MappedFile input("input.txt");
+    if (!input.is_open()) {
+        cout << "File cannot be opened" << endl;
+        return 1;
+    }
+
+    Stack<char> s;
+    read_filtered(input, s);
+    write_reversed(s, stdout);
+
     return 0;
 }
\ No newline at end of file
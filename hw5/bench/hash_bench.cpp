@@ -0,0 +1,333 @@
+// 散列表基准：比较 hw5.1 的开放寻址表、hw5.2 的链式表与 std::unordered_map
+//
+// 用法：hash_bench [n] [load] [dist] [find%] [insert%] [erase%] [ops]
+//   n     预先插入的 key 数（默认 100000）
+//   load  负载因子，固定容量的表按 n / load 设置桶数（默认 0.5）
+//   dist  key 分布：uniform | zipf | sequential | collide（均为桶数的倍数，key % 桶数 全部相同；
+//         全集受 INT_MAX / 桶数 限制）
+//   find% insert% erase%  操作比例（默认 80 10 10）
+//   ops   每张表执行的操作数（默认 1000000）
+//
+// 每张表输出吞吐量、单次操作的 p50/p99 延迟、每个元素占用的堆内存，
+// 以及查找命中时的探查距离 / 链上位置分布。
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <atomic>
+#include <new>
+#include <unordered_map>
+#include "../hw5.1/hash_tables.h"
+#include "../hw5.2/hash_chains.h"
+using namespace std;
+
+// 统计堆上仍在使用的字节数，用来估算每个元素的内存。
+// 替换的 operator new/delete 不能内联，否则 GCC 会把 malloc/free 与 new/delete 配对检查并误报
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+static atomic<long long> heapBytes(0);
+
+BENCH_NOINLINE void* operator new(size_t size) {
+    size_t* p = static_cast<size_t*>(malloc(size + sizeof(max_align_t)));
+    if (!p) throw bad_alloc();
+    *p = size;
+    heapBytes += (long long)size;
+    return reinterpret_cast<char*>(p) + sizeof(max_align_t);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    char* base = static_cast<char*>(ptr) - sizeof(max_align_t);
+    heapBytes -= (long long)*reinterpret_cast<size_t*>(base);
+    free(base);
+}
+
+BENCH_NOINLINE void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+enum class Op { Find, Insert, Erase };
+
+struct Workload {
+    int n;
+    double load;
+    string dist;
+    int findPct, insertPct, erasePct;
+    long long ops;
+    int buckets;          // 固定容量表的桶数
+    vector<int> prefill;  // 预先插入的 key
+    vector<int> keys;     // 每次操作的 key
+    vector<Op> kinds;     // 每次操作的类型
+};
+
+// Zipf(s) 分布的名次，名次 r 的概率正比于 1 / r^s
+class Zipf {
+public:
+    Zipf(int n, double s) : cdf(n) {
+        double sum = 0;
+        for (int r = 0; r < n; ++r) {
+            sum += 1.0 / pow(r + 1.0, s);
+            cdf[r] = sum;
+        }
+        for (auto& c : cdf) c /= sum;
+    }
+
+    int operator()(mt19937_64& gen) const {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(gen);
+        return (int)(lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+    }
+
+private:
+    vector<double> cdf;
+};
+
+// key 全集为 2n 个 key，前 n 个预先插入；查找、插入、删除都从全集中取 key，大约一半命中
+Workload makeWorkload(int n, double load, const string& dist, int f, int i, int e, long long ops) {
+    Workload w{n, load, dist, f, i, e, ops, max(1, (int)(n / load)), {}, {}, {}};
+    int universe = 2 * n;
+    if (dist == "collide") universe = (int)min<long long>(universe, INT_MAX / w.buckets);
+    vector<int> all(universe);
+    mt19937_64 gen(12345);
+    for (int k = 0; k < universe; ++k) {
+        if (dist == "sequential") {
+            all[k] = k;
+        } else if (dist == "collide") {
+            all[k] = k * w.buckets;
+        } else {
+            all[k] = (int)(gen() & 0x7FFFFFFF);
+        }
+    }
+    if (dist != "sequential" && dist != "collide") {
+        sort(all.begin(), all.end());
+        all.erase(unique(all.begin(), all.end()), all.end());
+        shuffle(all.begin(), all.end(), gen);
+        universe = (int)all.size();
+    }
+    w.prefill.assign(all.begin(), all.begin() + min(n, universe));
+
+    unique_ptr<Zipf> zipf;
+    if (dist == "zipf") zipf.reset(new Zipf(universe, 0.99));
+    int total = max(1, f + i + e);
+    w.keys.resize(ops);
+    w.kinds.resize(ops);
+    for (long long k = 0; k < ops; ++k) {
+        int idx;
+        if (zipf) {
+            idx = (*zipf)(gen);
+        } else if (dist == "sequential") {
+            idx = (int)(k % universe);
+        } else {
+            idx = (int)(gen() % universe);
+        }
+        w.keys[k] = all[idx];
+        int roll = (int)(gen() % total);
+        w.kinds[k] = roll < f ? Op::Find : roll < f + i ? Op::Insert : Op::Erase;
+    }
+    return w;
+}
+
+// 各种表统一成：insert(k) / find(k)（命中返回探查距离或链上位置，未命中 -1）/ erase(k)；
+// tracksProbes 为 false 的表拿不到探查距离，find 命中时一律返回 0
+struct LinearAdapter {
+    static const bool tracksProbes = true;
+    int cap;
+    LinearProbingHashTable t;
+    explicit LinearAdapter(const Workload& w) : cap(w.buckets), t(w.buckets) {}
+    void insert(int k) { t.put(k, "value"); }
+    int find(int k) {
+        auto r = t.lookup(k);
+        if (r.status != HashStatus::Found) return -1;
+        int home = (int)(ModuloHash()(k) % (size_t)cap);
+        return (r.index - home + cap) % cap;
+    }
+    void erase(int k) { t.remove(k); }
+};
+
+struct RobinHoodAdapter {
+    static const bool tracksProbes = true;
+    int cap;
+    RobinHoodHashTable t;
+    explicit RobinHoodAdapter(const Workload& w) : cap(w.buckets), t(w.buckets) {}
+    void insert(int k) { t.put(k, "value"); }
+    int find(int k) {
+        auto r = t.lookup(k);
+        if (r.status != HashStatus::Found) return -1;
+        return (r.index - k % cap + cap) % cap;
+    }
+    void erase(int k) { t.remove(k); }
+};
+
+struct SwissAdapter {
+    static const bool tracksProbes = false;
+    SwissHashTable t;
+    explicit SwissAdapter(const Workload& w) : t(w.buckets) {}
+    void insert(int k) { t.put(k, "value"); }
+    int find(int k) { return t.lookup(k).status == HashStatus::Found ? 0 : -1; }
+    void erase(int k) { t.remove(k); }
+};
+
+struct GrowableAdapter {
+    static const bool tracksProbes = false;
+    GrowableHashTable t;
+    explicit GrowableAdapter(const Workload&) : t(16, 0.75) {}
+    void insert(int k) { t.put(k, "value"); }
+    int find(int k) { return t.lookup(k).status == HashStatus::Found ? 0 : -1; }
+    void erase(int k) { t.remove(k); }
+};
+
+struct ChainAdapter {
+    static const bool tracksProbes = true;
+    hashChainsWithTail<int, string> t;
+    explicit ChainAdapter(const Workload& w) : t(w.buckets, 1e9) {}
+    void insert(int k) { t.insert(k, "value"); }
+    int find(int k) { return t.find(k).second.second; }
+    void erase(int k) { t.erase(k); }
+};
+
+struct BlockChainAdapter {
+    static const bool tracksProbes = true;
+    hashBlockChains<int, string> t;
+    explicit BlockChainAdapter(const Workload& w) : t(w.buckets) {}
+    void insert(int k) { t.insert(k, "value"); }
+    int find(int k) { return t.find(k).second.second; }
+    void erase(int k) { t.erase(k); }
+};
+
+struct StdAdapter {
+    static const bool tracksProbes = true;
+    unordered_map<int, string> t;
+    explicit StdAdapter(const Workload& w) { t.max_load_factor((float)max(1.0, w.load)); }
+    void insert(int k) { t[k] = "value"; }
+    int find(int k) {
+        auto it = t.find(k);
+        if (it == t.end()) return -1;
+        return (int)t.bucket_size(t.bucket(k)) - 1; // 桶内位置未知，用桶大小近似
+    }
+    void erase(int k) { t.erase(k); }
+};
+
+volatile long long benchSink;
+
+template <class Adapter>
+long long runOps(Adapter& a, const Workload& w, vector<long long>* hist, vector<double>* latency) {
+    long long acc = 0;
+    for (long long k = 0; k < w.ops; ++k) {
+        auto t0 = latency ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+        int key = w.keys[k];
+        switch (w.kinds[k]) {
+        case Op::Find: {
+            int d = a.find(key);
+            acc += d;
+            if (hist && d >= 0) (*hist)[min(d, (int)hist->size() - 1)]++;
+            break;
+        }
+        case Op::Insert:
+            a.insert(key);
+            break;
+        case Op::Erase:
+            a.erase(key);
+            break;
+        }
+        if (latency) {
+            (*latency)[k] = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+        }
+    }
+    return acc;
+}
+
+template <class Adapter>
+void runTable(const char* name, const Workload& w) {
+    long long before = heapBytes.load();
+    double bytesPerEntry;
+    double mops;
+    vector<long long> hist(17, 0);
+    {
+        unique_ptr<Adapter> a(new Adapter(w));
+        for (int k : w.prefill) a->insert(k);
+        bytesPerEntry = (double)(heapBytes.load() - before) / max<size_t>(1, w.prefill.size());
+
+        auto t0 = chrono::steady_clock::now();
+        benchSink = runOps(*a, w, &hist, nullptr);
+        auto t1 = chrono::steady_clock::now();
+        mops = w.ops / chrono::duration<double, micro>(t1 - t0).count();
+    }
+
+    vector<double> latency(w.ops);
+    {
+        unique_ptr<Adapter> a(new Adapter(w));
+        for (int k : w.prefill) a->insert(k);
+        benchSink = runOps(*a, w, nullptr, &latency);
+    }
+    sort(latency.begin(), latency.end());
+    double p50 = latency[latency.size() / 2];
+    double p99 = latency[min(latency.size() - 1, latency.size() * 99 / 100)];
+
+    printf("%-22s %8.2f Mops/s  p50 %6.0f ns  p99 %7.0f ns  %6.1f B/entry  probe:", name, mops, p50, p99,
+           bytesPerEntry);
+    if (!Adapter::tracksProbes) {
+        printf(" n/a\n");
+        return;
+    }
+    static const int edges[] = {0, 1, 2, 3, 4, 8, 16};
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i) {
+        int lo = edges[i];
+        int hi = i + 1 < sizeof(edges) / sizeof(edges[0]) ? edges[i + 1] : (int)hist.size();
+        long long c = 0;
+        for (int d = lo; d < hi; ++d) c += hist[d];
+        if (i + 1 == sizeof(edges) / sizeof(edges[0])) {
+            printf(" %d+:%lld", lo, c);
+        } else if (hi - lo == 1) {
+            printf(" %d:%lld", lo, c);
+        } else {
+            printf(" %d-%d:%lld", lo, hi - 1, c);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    double load = argc > 2 ? atof(argv[2]) : 0.5;
+    string dist = argc > 3 ? argv[3] : "uniform";
+    int f = argc > 4 ? atoi(argv[4]) : 80;
+    int i = argc > 5 ? atoi(argv[5]) : 10;
+    int e = argc > 6 ? atoi(argv[6]) : 10;
+    long long ops = argc > 7 ? atoll(argv[7]) : 1000000;
+    if (n <= 0 || load <= 0 || ops <= 0) {
+        cout << "WRONG" << endl;
+        return 1;
+    }
+    if (dist != "uniform" && dist != "zipf" && dist != "sequential" && dist != "collide") {
+        cout << "unknown distribution: " << dist << endl;
+        return 1;
+    }
+
+    Workload w = makeWorkload(n, load, dist, f, i, e, ops);
+    printf("n=%d load=%.2f buckets=%d dist=%s mix=%d/%d/%d ops=%lld\n", n, load, w.buckets, dist.c_str(), f, i, e,
+           ops);
+
+    // 开放寻址表的容量固定：负载因子不小于 1 时放不下，跳过
+    if (load < 1.0) {
+        runTable<LinearAdapter>("LinearProbing", w);
+        runTable<RobinHoodAdapter>("RobinHood", w);
+    }
+    runTable<SwissAdapter>("Swiss (grows)", w);
+    runTable<GrowableAdapter>("Growable (grows)", w);
+    runTable<ChainAdapter>("hashChainsWithTail", w);
+    runTable<BlockChainAdapter>("hashBlockChains", w);
+    runTable<StdAdapter>("std::unordered_map", w);
+    return 0;
+}
\ No newline at end of file
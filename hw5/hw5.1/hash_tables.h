@@ -0,0 +1,1238 @@
+// 开放寻址散列表：线性探查（含分片、快照）、Robin Hood、Swiss、可增长表，供 main.cpp 与 ../bench 共用
+#ifndef HW5_HASH_TABLES_H
+#define HW5_HASH_TABLES_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdio>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// 散列表操作结果：不分配内存，供热路径使用
+enum class HashStatus { Inserted, Updated, Found, NotFound, Removed, Full };
+
+template <class V>
+struct BasicHashResult {
+    HashStatus status;
+    int index;      // 操作涉及的桶，未知时为 -1
+    const V* value; // Found 时指向表中的值，其余为 nullptr
+};
+
+using HashResult = BasicHashResult<string>;
+
+// 短字符串直接存放在对象内部（最多 N 个字符），更长时才申请堆内存
+template <size_t N>
+class InlineString {
+public:
+    InlineString() {
+        setInline(0);
+    }
+
+    InlineString(string_view s) {
+        assign(s);
+    }
+
+    InlineString(const char* s) : InlineString(string_view(s)) {}
+
+    InlineString(const string& s) : InlineString(string_view(s)) {}
+
+    InlineString(const InlineString& other) {
+        assign(other.view());
+    }
+
+    InlineString(InlineString&& other) noexcept {
+        memcpy(raw, other.raw, sizeof(raw));
+        other.setInline(0);
+    }
+
+    InlineString& operator=(const InlineString& other) {
+        if (this != &other) {
+            release();
+            assign(other.view());
+        }
+        return *this;
+    }
+
+    InlineString& operator=(InlineString&& other) noexcept {
+        if (this != &other) {
+            release();
+            memcpy(raw, other.raw, sizeof(raw));
+            other.setInline(0);
+        }
+        return *this;
+    }
+
+    ~InlineString() {
+        release();
+    }
+
+    const char* data() const {
+        return isInline() ? raw : heap().ptr;
+    }
+
+    size_t size() const {
+        return isInline() ? N - (unsigned char)raw[N] : heap().len;
+    }
+
+    bool isInline() const {
+        return (unsigned char)raw[N] != HEAP;
+    }
+
+    string_view view() const {
+        return string_view(data(), size());
+    }
+
+    operator string_view() const {
+        return view();
+    }
+
+    void clear() {
+        release();
+        setInline(0);
+    }
+
+    friend bool operator==(const InlineString& a, const InlineString& b) {
+        return a.view() == b.view();
+    }
+
+    friend bool operator!=(const InlineString& a, const InlineString& b) {
+        return !(a == b);
+    }
+
+private:
+    static const unsigned char HEAP = 0xFF;
+
+    struct Heap {
+        char* ptr;
+        size_t len;
+    };
+
+    // raw[N] 必须在 Heap 之后，否则写入 HEAP 标记会覆盖 len
+    static_assert(N >= sizeof(Heap) && N < 255, "InlineString: N must be in [sizeof(Heap), 254]");
+
+    // raw[N] 存 N - 长度（内联时）或 HEAP；内联长度为 N 时 raw[N] 恰为 0，兼作结尾的 '\0'
+    alignas(Heap) char raw[N + 1];
+
+    const Heap& heap() const {
+        return *reinterpret_cast<const Heap*>(raw);
+    }
+
+    Heap& heap() {
+        return *reinterpret_cast<Heap*>(raw);
+    }
+
+    void setInline(size_t len) {
+        raw[len] = '\0';
+        raw[N] = (char)(N - len);
+    }
+
+    void assign(string_view s) {
+        if (s.size() <= N) {
+            memcpy(raw, s.data(), s.size());
+            setInline(s.size());
+        } else {
+            char* p = new char[s.size() + 1];
+            memcpy(p, s.data(), s.size());
+            p[s.size()] = '\0';
+            heap().ptr = p;
+            heap().len = s.size();
+            raw[N] = (char)HEAP;
+        }
+    }
+
+    void release() {
+        if (!isInline()) delete[] heap().ptr;
+    }
+};
+
+// int key 的恒等哈希：桶号就是 key % capacity（非负 key），不依赖标准库 hash<int> 的实现
+struct ModuloHash {
+    size_t operator()(int key) const {
+        return (size_t)key;
+    }
+};
+
+// 可与 string_view / const char* 直接比较的字符串哈希（透明哈希，用于异构查找）
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(string_view s) const {
+        return hash<string_view>()(s);
+    }
+};
+
+inline void appendValue(string& out, const string& v) {
+    out += v;
+}
+
+template <size_t N>
+void appendValue(string& out, const InlineString<N>& v) {
+    out += v.view();
+}
+
+template <class V>
+void appendValue(string& out, const V& v) {
+    ostringstream ss;
+    ss << v;
+    out += ss.str();
+}
+
+// 按 "{found, index:3, value:c}" 的格式输出结果（展示层）
+template <class V>
+string toString(const BasicHashResult<V>& r) {
+    static const char* const names[] = {"inserted", "updated", "found", "not_found", "removed", "full"};
+    string out = "{";
+    out += names[(int)r.status];
+    if (r.index >= 0) out += ", index:" + to_string(r.index);
+    if (r.value) {
+        out += ", value:";
+        appendValue(out, *r.value);
+    }
+    return out + "}";
+}
+
+// 线性探查散列表，key / value 类型、哈希函数与相等比较均可指定。
+// Hash 与 KeyEqual 都声明 is_transparent 时，lookup / remove 接受任何可比较的类型
+// （例如用 string_view 查 string key），不必先构造临时 key。
+template <class K, class V, class Hash = hash<K>, class KeyEqual = equal_to<K>>
+class BasicLinearProbingHashTable {
+private:
+    struct Entry {
+        K key;
+        V value;
+        bool inUse;     // 表示该桶当前是否有有效数据（未被删除）
+        bool neverUsed; // 表示该桶是否从未被使用过（包括未插入和未删除）
+    };
+
+    // Hash 与 KeyEqual 均为透明时才启用异构查找重载
+    template <class T, class = void>
+    struct IsTransparent : false_type {};
+
+    template <class T>
+    struct IsTransparent<T, void_t<typename T::is_transparent>> : true_type {};
+
+    template <class H, class E>
+    using EnableHetero = enable_if_t<IsTransparent<H>::value && IsTransparent<E>::value>;
+
+    using Result = BasicHashResult<V>;
+
+    vector<Entry> table;
+    int capacity;
+    int size; // 当前有效数据个数（inUse=true 的桶数）
+    int deletedCount; // 空桶中 neverUsed=false 的桶数（已删除的桶）
+    Hash hasher;
+    KeyEqual equal;
+
+    // 哈希函数
+    template <class Q>
+    int hash(const Q& key) const {
+        return (int)(hasher(key) % (size_t)capacity);
+    }
+
+    // 计算空桶中 neverUsed=false 的比例（用于触发重组织），由计数器 O(1) 得出
+    double getNeverUsedFalseRatio() {
+        int emptyCount = capacity - size; // 空桶总数（inUse=false 的桶）
+        return emptyCount == 0 ? 0.0 : (double)deletedCount / emptyCount;
+    }
+
+    // 原地重组织散列表：空桶 neverUsed 设为 true，有效数据就地换到新位置，不复制整张表
+    // 过程中 inUse=true 且 neverUsed=true 表示“待安放”，inUse=true 且 neverUsed=false 表示“已安放”
+    void reorganize() {
+        for (auto& entry : table) {
+            entry.neverUsed = true;
+            if (!entry.inUse) {
+                entry.value = V();
+            }
+        }
+        deletedCount = 0;
+
+        for (int i = 0; i < capacity; ++i) {
+            while (table[i].inUse && table[i].neverUsed) {
+                // 从哈希位置起找第一个未安放的桶（空桶或待安放的桶）
+                int target = hash(table[i].key);
+                while (table[target].inUse && !table[target].neverUsed) {
+                    target = (target + 1) % capacity;
+                }
+                // 目标为空桶时 i 变为空桶；目标待安放时继续安放换回 i 的数据
+                if (target != i) {
+                    swap(table[i], table[target]);
+                }
+                table[target].neverUsed = false;
+            }
+        }
+    }
+
+    template <class Q>
+    Result lookupAny(const Q& key) const {
+        int index = hash(key);
+        int start = index;
+        int finalIndex = start; // 记录探查终止时的索引
+
+        do {
+            finalIndex = index; // 更新当前探查索引为最终索引
+            // 桶从未使用过，无需继续探查（后续桶也不可能有目标key）
+            if (table[index].neverUsed) {
+                break;
+            }
+            // 找到目标key，返回结果
+            if (table[index].inUse && equal(table[index].key, key)) {
+                return {HashStatus::Found, index, &table[index].value};
+            }
+
+            index = (index + 1) % capacity;
+        } while (index != start);
+
+        // 未找到：返回探查终止时的索引
+        return {HashStatus::NotFound, finalIndex, nullptr};
+    }
+
+    template <class Q>
+    Result removeAny(const Q& key) {
+        int index = hash(key);
+        int start = index;
+
+        do {
+            // 桶从未使用过，无需继续探查
+            if (table[index].neverUsed) {
+                break;
+            }
+            // 找到目标key且有效，标记为删除
+            if (table[index].inUse && equal(table[index].key, key)) {
+                table[index].inUse = false;
+                size--;
+                deletedCount++;
+                return {HashStatus::Removed, index, nullptr};
+            }
+
+            index = (index + 1) % capacity;
+        } while (index != start);
+
+        // 未找到
+        return {HashStatus::NotFound, start, nullptr};
+    }
+
+public:
+    BasicLinearProbingHashTable(int cap, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual())
+        : capacity(cap), size(0), deletedCount(0), hasher(h), equal(eq) {
+        table.assign(capacity, {K(), V(), false, true});
+    }
+
+    // 插入接口
+    Result put(const K& key, const V& value) {
+        if (getNeverUsedFalseRatio() >= 0.6) {
+            reorganize();
+        }
+
+        int index = hash(key);
+        int start = index;
+        int firstDeletedIndex = -1; // 记录第一个遇到的已删除桶（inUse=false）
+
+        do {
+            // 情况1：桶从未使用过（neverUsed=true）—— 直接插入
+            if (table[index].neverUsed) {
+                // 优先使用之前找到的已删除桶（如果有）
+                if (firstDeletedIndex != -1) {
+                    index = firstDeletedIndex;
+                    deletedCount--;
+                }
+                table[index].key = key;
+                table[index].value = value;
+                table[index].inUse = true;
+                table[index].neverUsed = false;
+                size++;
+                return {HashStatus::Inserted, index, nullptr};
+            }
+            // 情况2：桶已使用过（neverUsed=false）
+            else {
+                // 找到相同key，更新值
+                if (equal(table[index].key, key)) {
+                    table[index].value = value;
+                    return {HashStatus::Updated, index, nullptr};
+                }
+                // 遇到已删除的桶，记录第一个位置（用于后续插入）
+                if (!table[index].inUse && firstDeletedIndex == -1) {
+                    firstDeletedIndex = index;
+                }
+            }
+
+            index = (index + 1) % capacity;
+        } while (index != start);
+
+        // 循环结束：表满（无从未使用的桶，且无已删除的桶）
+        return {HashStatus::Full, start, nullptr};
+    }
+
+    // 查找接口：返回探查终止时的索引（而非初始哈希索引）
+    Result lookup(const K& key) const {
+        return lookupAny(key);
+    }
+
+    template <class Q, class H = Hash, class E = KeyEqual, class = EnableHetero<H, E>>
+    Result lookup(const Q& key) const {
+        return lookupAny(key);
+    }
+
+    // 删除接口：仅标记 inUse=false，不改变 neverUsed
+    Result remove(const K& key) {
+        return removeAny(key);
+    }
+
+    template <class Q, class H = Hash, class E = KeyEqual, class = EnableHetero<H, E>>
+    Result remove(const Q& key) {
+        return removeAny(key);
+    }
+
+    // 按桶只读访问（供快照等需要原样保存表结构的工具使用）
+    struct BucketView {
+        const K* key;
+        const V* value;
+        bool inUse;
+        bool neverUsed;
+    };
+
+    int bucketCount() const {
+        return capacity;
+    }
+
+    BucketView bucket(int i) const {
+        const Entry& e = table[i];
+        return {&e.key, &e.value, e.inUse, e.neverUsed};
+    }
+
+    // 字符串形式的接口
+    string insert(const K& key, const V& value) {
+        return toString(put(key, value));
+    }
+
+    string find(const K& key) const {
+        return toString(lookup(key));
+    }
+
+    template <class Q, class H = Hash, class E = KeyEqual, class = EnableHetero<H, E>>
+    string find(const Q& key) const {
+        return toString(lookup(key));
+    }
+
+    string erase(const K& key) {
+        return toString(remove(key));
+    }
+
+    template <class Q, class H = Hash, class E = KeyEqual, class = EnableHetero<H, E>>
+    string erase(const Q& key) {
+        return toString(remove(key));
+    }
+};
+
+using LinearProbingHashTable = BasicLinearProbingHashTable<int, string, ModuloHash>;
+
+// string key、短 value 内联存放的散列表，可直接用 string_view 查找
+using StringHashTable = BasicLinearProbingHashTable<string, InlineString<22>, StringHash, equal_to<>>;
+
+// 多线程共享的分片散列表：按哈希值高位把 key 分到 2^ShardBits 个 BasicLinearProbingHashTable，
+// 每个分片一把读写锁，读操作只取共享锁，不同分片的写操作互不阻塞。
+// 表内的值可能被其他线程改写，因此查找把值拷贝出来（get）或在锁内访问（visit），不返回指针。
+template <class K, class V, class Hash = hash<K>, class KeyEqual = equal_to<K>, int ShardBits = 4>
+class ShardedHashTable {
+private:
+    using Table = BasicLinearProbingHashTable<K, V, Hash, KeyEqual>;
+
+    // 每个分片独占缓存行，避免相邻分片的锁互相干扰
+    struct alignas(64) Shard {
+        mutable shared_mutex lock;
+        Table table;
+
+        Shard(int cap, const Hash& h, const KeyEqual& eq) : table(cap, h, eq) {}
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    Hash hasher;
+
+    template <class Q>
+    Shard& shardFor(const Q& key) const {
+        uint64_t h = (uint64_t)hasher(key) * 0x9E3779B97F4A7C15ULL;
+        return *shards[ShardBits == 0 ? 0 : h >> (64 - ShardBits) % 64];
+    }
+
+public:
+    static_assert(ShardBits >= 0 && ShardBits <= 16, "ShardedHashTable: ShardBits must be in [0, 16]");
+
+    // capacity 为总容量，平均分给各分片
+    explicit ShardedHashTable(int capacity, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual())
+        : hasher(h) {
+        int shardCapacity = max(1, (capacity + (1 << ShardBits) - 1) >> ShardBits);
+        for (int i = 0; i < (1 << ShardBits); ++i) {
+            shards.emplace_back(new Shard(shardCapacity, h, eq));
+        }
+    }
+
+    HashStatus put(const K& key, const V& value) {
+        Shard& s = shardFor(key);
+        unique_lock<shared_mutex> guard(s.lock);
+        return s.table.put(key, value).status;
+    }
+
+    template <class Q>
+    bool get(const Q& key, V& out) const {
+        Shard& s = shardFor(key);
+        shared_lock<shared_mutex> guard(s.lock);
+        auto r = s.table.lookup(key);
+        if (r.status != HashStatus::Found) return false;
+        out = *r.value;
+        return true;
+    }
+
+    // 持有共享锁时以 f(const V&) 访问值，返回是否找到
+    template <class Q, class F>
+    bool visit(const Q& key, F f) const {
+        Shard& s = shardFor(key);
+        shared_lock<shared_mutex> guard(s.lock);
+        auto r = s.table.lookup(key);
+        if (r.status != HashStatus::Found) return false;
+        f(*r.value);
+        return true;
+    }
+
+    template <class Q>
+    bool remove(const Q& key) {
+        Shard& s = shardFor(key);
+        unique_lock<shared_mutex> guard(s.lock);
+        return s.table.remove(key).status == HashStatus::Removed;
+    }
+};
+
+// LinearProbingHashTable 的快照文件，布局与内存中的桶数组一一对应：
+//   SnapshotHeader | SnapshotBucket[capacity] | 字符串区
+// 字符串以相对文件开头的偏移引用，文件可映射到任意地址直接使用，加载时无需重新散列。
+// 文件按本机字节序写入，magic 用于识别字节序不符或格式不对的文件。
+struct SnapshotHeader {
+    uint64_t magic;
+    uint32_t version;
+    int32_t capacity;
+    int32_t size;
+    int32_t reserved;
+    uint64_t bucketOffset;
+    uint64_t arenaOffset;
+    uint64_t arenaSize;
+};
+
+struct SnapshotBucket {
+    uint64_t valueOffset; // 值在文件中的偏移
+    uint32_t valueLength;
+    int32_t key;
+    uint8_t inUse;
+    uint8_t neverUsed;
+    uint8_t pad[6];
+};
+
+const uint64_t SNAPSHOT_MAGIC = 0x31504E534854504CULL; // "LPTHSNP1"
+const uint32_t SNAPSHOT_VERSION = 1;
+
+// 把表写成快照文件，成功返回 true
+inline bool saveSnapshot(const LinearProbingHashTable& ht, const string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    int capacity = ht.bucketCount();
+    SnapshotHeader header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.capacity = capacity;
+    header.bucketOffset = sizeof(SnapshotHeader);
+    header.arenaOffset = header.bucketOffset + (uint64_t)capacity * sizeof(SnapshotBucket);
+
+    vector<SnapshotBucket> buckets(capacity);
+    uint64_t arenaSize = 0;
+    for (int i = 0; i < capacity; ++i) {
+        auto b = ht.bucket(i);
+        SnapshotBucket& out = buckets[i];
+        memset(&out, 0, sizeof(out));
+        out.key = *b.key;
+        out.inUse = b.inUse;
+        out.neverUsed = b.neverUsed;
+        if (b.inUse) {
+            out.valueOffset = header.arenaOffset + arenaSize;
+            out.valueLength = (uint32_t)b.value->size();
+            arenaSize += b.value->size();
+            header.size++;
+        }
+    }
+    header.arenaSize = arenaSize;
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = ok && (capacity == 0 || fwrite(buckets.data(), sizeof(SnapshotBucket), capacity, f) == (size_t)capacity);
+    for (int i = 0; ok && i < capacity; ++i) {
+        auto b = ht.bucket(i);
+        if (b.inUse && !b.value->empty()) {
+            ok = fwrite(b.value->data(), 1, b.value->size(), f) == b.value->size();
+        }
+    }
+    return fclose(f) == 0 && ok;
+}
+
+struct SnapshotResult {
+    HashStatus status;
+    int index;
+    string_view value; // 指向映射中的字符串，仅 Found 时有效
+};
+
+// 只读映射快照文件并直接在映射上查找，与 LinearProbingHashTable::find() 的探查方式与结果相同
+class MappedHashTable {
+private:
+    const char* base;
+    size_t length;
+    bool mapped;
+    vector<char> copy; // 不支持 mmap 时读入内存
+    const SnapshotHeader* header;
+    const SnapshotBucket* buckets;
+
+    int hash(int key) const {
+        return (int)(ModuloHash()(key) % (size_t)header->capacity);
+    }
+
+    bool validate() {
+        if (length < sizeof(SnapshotHeader)) return false;
+        header = reinterpret_cast<const SnapshotHeader*>(base);
+        if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION) return false;
+        if (header->capacity <= 0 || header->bucketOffset != sizeof(SnapshotHeader)) return false;
+        uint64_t bucketEnd = header->bucketOffset + (uint64_t)header->capacity * sizeof(SnapshotBucket);
+        if (header->arenaOffset != bucketEnd || bucketEnd > length || header->arenaSize > length - bucketEnd) {
+            return false;
+        }
+        buckets = reinterpret_cast<const SnapshotBucket*>(base + header->bucketOffset);
+        return true;
+    }
+
+    // 桶中的值必须落在字符串区内；打开时不逐桶检查，以免 O(capacity) 地读遍整个桶数组
+    bool valueInArena(const SnapshotBucket& b) const {
+        uint64_t arenaEnd = header->arenaOffset + header->arenaSize;
+        return b.valueOffset >= header->arenaOffset && b.valueOffset <= arenaEnd &&
+               b.valueLength <= arenaEnd - b.valueOffset;
+    }
+
+    void unmap() {
+#ifdef HAVE_MMAP
+        if (mapped) munmap(const_cast<char*>(base), length);
+#endif
+        mapped = false;
+        base = nullptr;
+        length = 0;
+        copy.clear();
+        header = nullptr;
+        buckets = nullptr;
+    }
+
+public:
+    MappedHashTable() : base(nullptr), length(0), mapped(false), header(nullptr), buckets(nullptr) {}
+
+    ~MappedHashTable() {
+        unmap();
+    }
+
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+
+    // 打开快照，文件不存在或格式不对时返回 false
+    bool open(const string& path) {
+        unmap();
+#ifdef HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) {
+                base = static_cast<const char*>(p);
+                length = (size_t)st.st_size;
+                mapped = true;
+            }
+        }
+        close(fd);
+#endif
+        if (!mapped) {
+            FILE* f = fopen(path.c_str(), "rb");
+            if (!f) return false;
+            char chunk[1 << 16];
+            size_t got;
+            while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+                copy.insert(copy.end(), chunk, chunk + got);
+            }
+            fclose(f);
+            base = copy.data();
+            length = copy.size();
+        }
+        if (!validate()) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    int size() const {
+        return header ? header->size : 0;
+    }
+
+    // 未成功打开时一律返回 NotFound，index 为 -1
+    SnapshotResult lookup(int key) const {
+        if (!header) return {HashStatus::NotFound, -1, string_view()};
+        int capacity = header->capacity;
+        int index = hash(key);
+        int start = index;
+        int finalIndex = start;
+
+        do {
+            finalIndex = index;
+            const SnapshotBucket& b = buckets[index];
+            if (b.neverUsed) {
+                break;
+            }
+            if (b.inUse && b.key == key) {
+                if (!valueInArena(b)) break; // 损坏的桶按未找到处理
+                return {HashStatus::Found, index, string_view(base + b.valueOffset, b.valueLength)};
+            }
+
+            index = (index + 1) % capacity;
+        } while (index != start);
+
+        return {HashStatus::NotFound, finalIndex, string_view()};
+    }
+
+    string find(int key) const {
+        SnapshotResult r = lookup(key);
+        if (r.status != HashStatus::Found) return "{not_found, index:" + to_string(r.index) + "}";
+        return "{found, index:" + to_string(r.index) + ", value:" + string(r.value) + "}";
+    }
+};
+
+// Robin Hood 探查的散列表：与 LinearProbingHashTable 同样按 key % capacity 定位、线性探查，
+// 但插入时让离家更远的数据优先占桶，删除时把后续数据整体前移（backward shift），
+// 因此没有 neverUsed 墓碑，也不需要周期性重组织；查找遇到离家距离更短的桶即可提前结束。
+class RobinHoodHashTable {
+private:
+    struct Entry {
+        int key;
+        string value;
+        int dist; // 离哈希位置的距离，-1 表示空桶
+    };
+
+    vector<Entry> table;
+    int capacity;
+    int size;
+
+    int hash(int key) const {
+        int h = key % capacity;
+        return h < 0 ? h + capacity : h;
+    }
+
+    int next(int index) const {
+        return index + 1 == capacity ? 0 : index + 1;
+    }
+
+    // 返回 key 所在桶；不存在时返回 -1，并把探查终止的位置写入 stop
+    int locate(int key, int& stop) const {
+        int index = hash(key);
+        for (int d = 0; d < capacity; ++d, index = next(index)) {
+            const Entry& e = table[index];
+            if (e.dist < d) break; // 空桶（-1）或离家更近的数据：key 不可能在后面
+            if (e.key == key) return index;
+        }
+        stop = index;
+        return -1;
+    }
+
+public:
+    struct ProbeStats {
+        int maxProbe;          // 最长探查距离
+        double meanProbe;      // 平均探查距离
+        vector<int> histogram; // histogram[d]：离家距离为 d 的数据个数
+    };
+
+    RobinHoodHashTable(int cap) : capacity(cap), size(0) {
+        table.assign(capacity, {0, "", -1});
+    }
+
+    HashResult put(int key, const string& value) {
+        int stop;
+        int found = locate(key, stop);
+        if (found >= 0) {
+            table[found].value = value;
+            return {HashStatus::Updated, found, nullptr};
+        }
+        if (size == capacity) {
+            return {HashStatus::Full, hash(key), nullptr};
+        }
+
+        Entry carry{key, value, 0};
+        int index = hash(key);
+        int placed = -1;
+        for (;; index = next(index), ++carry.dist) {
+            Entry& e = table[index];
+            if (e.dist < 0) {
+                e = std::move(carry);
+                if (placed < 0) placed = index;
+                break;
+            }
+            // 富者让贫者：当前桶的数据离家更近，把位置让给 carry，转而安放被换出的数据
+            if (e.dist < carry.dist) {
+                swap(e, carry);
+                if (placed < 0) placed = index;
+            }
+        }
+        size++;
+        return {HashStatus::Inserted, placed, nullptr};
+    }
+
+    HashResult lookup(int key) const {
+        int stop;
+        int index = locate(key, stop);
+        if (index < 0) return {HashStatus::NotFound, stop, nullptr};
+        return {HashStatus::Found, index, &table[index].value};
+    }
+
+    HashResult remove(int key) {
+        int stop;
+        int index = locate(key, stop);
+        if (index < 0) return {HashStatus::NotFound, stop, nullptr};
+
+        // 后续离家距离大于 0 的数据逐个前移一格
+        int hole = index;
+        for (int j = next(hole); table[j].dist > 0; j = next(j)) {
+            table[hole] = std::move(table[j]);
+            table[hole].dist--;
+            hole = j;
+        }
+        table[hole].value.clear();
+        table[hole].dist = -1;
+        size--;
+        return {HashStatus::Removed, index, nullptr};
+    }
+
+    string insert(int key, const string& value) {
+        return toString(put(key, value));
+    }
+
+    string find(int key) const {
+        return toString(lookup(key));
+    }
+
+    string erase(int key) {
+        return toString(remove(key));
+    }
+
+    ProbeStats probeStats() const {
+        ProbeStats stats{0, 0.0, {}};
+        long long total = 0;
+        for (const auto& e : table) {
+            if (e.dist < 0) continue;
+            if (e.dist >= (int)stats.histogram.size()) stats.histogram.resize(e.dist + 1, 0);
+            stats.histogram[e.dist]++;
+            stats.maxProbe = max(stats.maxProbe, e.dist);
+            total += e.dist;
+        }
+        stats.meanProbe = size == 0 ? 0.0 : (double)total / size;
+        return stats;
+    }
+};
+
+// Swiss table 风格的散列表：每个桶对应 1 字节控制字（空 / 已删除 / 哈希值的低 7 位），
+// 控制字每 16 个一组，用 SSE2 一次比较一组；key 与 value 分开存放，
+// 未命中的查找通常只读一组控制字（一条缓存行）就能结束。负载超过 7/8 时整体重建。
+class SwissHashTable {
+private:
+    static const int GROUP = 16;
+    static const uint8_t EMPTY = 0x80;
+    static const uint8_t DELETED = 0xFE;
+
+    unique_ptr<uint8_t[]> ctrl;
+    unique_ptr<int[]> keys;
+    unique_ptr<string[]> values;
+    int capacity;   // 2 的幂，且为 GROUP 的倍数
+    int size;
+    int growthLeft; // 还能占用多少个空桶而不需要重建
+
+    static uint64_t hash(int key) {
+        uint64_t h = (uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL;
+        return h ^ (h >> 32);
+    }
+
+    static uint8_t h2(uint64_t h) {
+        return (uint8_t)(h >> 57); // 高 7 位，最高位为 0 表示“有数据”
+    }
+
+    // 组内与 tag 相等的桶的位掩码
+    uint32_t match(int group, uint8_t tag) const {
+        const uint8_t* c = ctrl.get() + group * GROUP;
+#ifdef __SSE2__
+        __m128i v = _mm_loadu_si128((const __m128i*)c);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)tag)));
+#else
+        uint32_t mask = 0;
+        for (int i = 0; i < GROUP; ++i) {
+            if (c[i] == tag) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    // 组内空桶或已删除桶（最高位为 1）的位掩码
+    uint32_t matchFree(int group) const {
+        const uint8_t* c = ctrl.get() + group * GROUP;
+#ifdef __SSE2__
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)c));
+#else
+        uint32_t mask = 0;
+        for (int i = 0; i < GROUP; ++i) {
+            if (c[i] & 0x80) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    static int lowestBit(uint32_t mask) {
+        int i = 0;
+        while (!(mask & 1u)) {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+    }
+
+    int groups() const {
+        return capacity / GROUP;
+    }
+
+    void allocate(int cap) {
+        capacity = cap;
+        ctrl.reset(new uint8_t[cap]);
+        keys.reset(new int[cap]);
+        values.reset(new string[cap]);
+        for (int i = 0; i < cap; ++i) ctrl[i] = EMPTY;
+        size = 0;
+        growthLeft = cap - cap / 8;
+    }
+
+    // 按组做三角数探查：g, g+1, g+3, g+6, ...，组数为 2 的幂时遍历所有组
+    int locate(int key, uint64_t h) const {
+        int mask = groups() - 1;
+        int group = (int)(h >> 7) & mask;
+        uint8_t tag = h2(h);
+        for (int step = 1; step <= groups(); group = (group + step++) & mask) {
+            for (uint32_t m = match(group, tag); m; m &= m - 1) {
+                int index = group * GROUP + lowestBit(m);
+                if (keys[index] == key) return index;
+            }
+            if (match(group, EMPTY)) break;
+        }
+        return -1;
+    }
+
+    // 第一个可用的空桶或已删除桶
+    int findFree(uint64_t h) const {
+        int mask = groups() - 1;
+        int group = (int)(h >> 7) & mask;
+        for (int step = 1;; group = (group + step++) & mask) {
+            uint32_t m = matchFree(group);
+            if (m) return group * GROUP + lowestBit(m);
+        }
+    }
+
+    void rehash(int cap) {
+        unique_ptr<uint8_t[]> oldCtrl = std::move(ctrl);
+        unique_ptr<int[]> oldKeys = std::move(keys);
+        unique_ptr<string[]> oldValues = std::move(values);
+        int oldCapacity = capacity;
+        allocate(cap);
+        for (int i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] & 0x80) continue;
+            uint64_t h = hash(oldKeys[i]);
+            int index = findFree(h);
+            ctrl[index] = h2(h);
+            keys[index] = oldKeys[i];
+            values[index] = std::move(oldValues[i]);
+            size++;
+            growthLeft--;
+        }
+    }
+
+public:
+    explicit SwissHashTable(int initialCapacity = GROUP) {
+        int cap = GROUP;
+        while (cap < initialCapacity) cap *= 2;
+        allocate(cap);
+    }
+
+    HashResult put(int key, const string& value) {
+        uint64_t h = hash(key);
+        int index = locate(key, h);
+        if (index >= 0) {
+            values[index] = value;
+            return {HashStatus::Updated, index, nullptr};
+        }
+        index = findFree(h);
+        if (growthLeft == 0 && ctrl[index] == EMPTY) {
+            // 空桶用完：已删除桶多时同容量重建，否则容量翻倍
+            rehash(size + 1 > (capacity - capacity / 8) / 2 ? capacity * 2 : capacity);
+            index = findFree(h);
+        }
+        if (ctrl[index] == EMPTY) growthLeft--;
+        ctrl[index] = h2(h);
+        keys[index] = key;
+        values[index] = value;
+        size++;
+        return {HashStatus::Inserted, index, nullptr};
+    }
+
+    HashResult lookup(int key) const {
+        int index = locate(key, hash(key));
+        if (index < 0) return {HashStatus::NotFound, -1, nullptr};
+        return {HashStatus::Found, index, &values[index]};
+    }
+
+    HashResult remove(int key) {
+        int index = locate(key, hash(key));
+        if (index < 0) return {HashStatus::NotFound, -1, nullptr};
+        // 组内还有空桶时，探查不会越过这一组，可以直接标记为空
+        if (match(index / GROUP, EMPTY)) {
+            ctrl[index] = EMPTY;
+            growthLeft++;
+        } else {
+            ctrl[index] = DELETED;
+        }
+        values[index].clear();
+        size--;
+        return {HashStatus::Removed, index, nullptr};
+    }
+
+    string insert(int key, const string& value) {
+        return toString(put(key, value));
+    }
+
+    string find(int key) const {
+        return toString(lookup(key));
+    }
+
+    string erase(int key) {
+        return toString(remove(key));
+    }
+
+    int count() const {
+        return size;
+    }
+};
+
+// 可扩容的线性探查散列表
+// 容量始终为 2 的幂，哈希用乘法移位（取 key * 黄金比例常数 的高位）代替取模；
+// (有效数据 + 已删除桶) 超过 maxLoad * capacity 时扩容，旧表中的桶在之后的每次操作中
+// 分批迁移到新表（渐进式 rehash），单次插入不会出现整表重建的停顿。
+class GrowableHashTable {
+private:
+    struct Entry {
+        int key;
+        string value;
+        bool inUse;     // 表示该桶当前是否有有效数据（未被删除）
+        bool neverUsed; // 表示该桶是否从未被使用过（包括未插入和未删除）
+    };
+
+    struct Table {
+        vector<Entry> slots;
+        int bits = 0;   // capacity = 1 << bits
+        int used = 0;   // neverUsed=false 的桶数（有效数据 + 已删除）
+        int size = 0;   // inUse=true 的桶数
+
+        int capacity() const {
+            return (int)slots.size();
+        }
+
+        void reset(int b) {
+            bits = b;
+            slots.assign(size_t(1) << b, {0, "", false, true});
+            used = 0;
+            size = 0;
+        }
+
+        // 乘法移位哈希
+        int hash(int key) const {
+            return (int)(((uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+        }
+
+        // 返回 key 所在桶，不存在返回 -1
+        int find(int key) const {
+            int mask = capacity() - 1;
+            for (int index = hash(key), probes = 0; probes < capacity(); index = (index + 1) & mask, ++probes) {
+                const Entry& e = slots[index];
+                if (e.neverUsed) break;
+                if (e.inUse && e.key == key) return index;
+            }
+            return -1;
+        }
+
+        // 插入一个确定不存在的 key，优先复用第一个已删除桶
+        int place(int key, string&& value) {
+            int mask = capacity() - 1;
+            int index = hash(key);
+            while (slots[index].inUse) index = (index + 1) & mask;
+            Entry& e = slots[index];
+            if (e.neverUsed) ++used;
+            e.key = key;
+            e.value = std::move(value);
+            e.inUse = true;
+            e.neverUsed = false;
+            ++size;
+            return index;
+        }
+
+        void remove(int index) {
+            slots[index].inUse = false;
+            slots[index].value.clear();
+            --size;
+        }
+    };
+
+    static const int MIGRATE_PER_OP = 8; // 每次操作迁移的旧桶数
+    static const int MIN_BITS = 3;
+
+    Table cur;        // 新数据总是写入 cur
+    Table old;        // 渐进式 rehash 期间尚未迁移完的旧表
+    int migrateIndex; // old 中下一个待迁移的桶
+    double maxLoad;
+
+    bool migrating() const {
+        return !old.slots.empty();
+    }
+
+    // 迁移 old 中最多 n 个桶
+    void migrate(int n) {
+        while (migrating() && n-- > 0) {
+            Entry& e = old.slots[migrateIndex];
+            if (e.inUse) {
+                cur.place(e.key, std::move(e.value));
+                e.inUse = false;
+                --old.size;
+            }
+            if (++migrateIndex == old.capacity() || old.size == 0) {
+                old.slots.clear();
+                old.slots.shrink_to_fit();
+                old.size = old.used = 0;
+            }
+        }
+    }
+
+    // 插入前检查负载，需要时开始新一轮渐进式 rehash
+    void reserveOne() {
+        if (cur.used + 1 <= maxLoad * cur.capacity()) return;
+        migrate(old.capacity()); // 上一轮尚未结束：先完成它
+        // 已删除桶占多数时同容量重建即可清理
+        int bits = cur.size + 1 > maxLoad * cur.capacity() / 2 ? cur.bits + 1 : cur.bits;
+        old = std::move(cur);
+        cur = Table();
+        cur.reset(bits);
+        migrateIndex = 0;
+        if (old.size == 0) {
+            old.slots.clear();
+            old.used = 0;
+        }
+    }
+
+public:
+    explicit GrowableHashTable(int initialCapacity = 8, double maxLoadFactor = 0.75)
+        : migrateIndex(0), maxLoad(maxLoadFactor) {
+        if (maxLoad <= 0.0 || maxLoad >= 1.0) {
+            throw invalid_argument("GrowableHashTable: max load factor must be in (0, 1)");
+        }
+        int bits = MIN_BITS;
+        while ((1 << bits) < initialCapacity) ++bits;
+        cur.reset(bits);
+    }
+
+    HashResult put(int key, const string& value) {
+        migrate(MIGRATE_PER_OP);
+        int index = cur.find(key);
+        if (index >= 0) {
+            cur.slots[index].value = value;
+            return {HashStatus::Updated, index, nullptr};
+        }
+        if (migrating()) {
+            int oldIndex = old.find(key);
+            if (oldIndex >= 0) old.remove(oldIndex);
+        }
+        reserveOne();
+        index = cur.place(key, string(value));
+        return {HashStatus::Inserted, index, nullptr};
+    }
+
+    HashResult lookup(int key) {
+        migrate(MIGRATE_PER_OP);
+        const Table* t = &cur;
+        int index = cur.find(key);
+        if (index < 0 && migrating()) {
+            t = &old;
+            index = old.find(key);
+        }
+        if (index < 0) return {HashStatus::NotFound, -1, nullptr};
+        return {HashStatus::Found, index, &t->slots[index].value};
+    }
+
+    HashResult remove(int key) {
+        migrate(MIGRATE_PER_OP);
+        Table* t = &cur;
+        int index = cur.find(key);
+        if (index < 0 && migrating()) {
+            t = &old;
+            index = old.find(key);
+        }
+        if (index < 0) return {HashStatus::NotFound, -1, nullptr};
+        t->remove(index);
+        return {HashStatus::Removed, index, nullptr};
+    }
+
+    string insert(int key, const string& value) {
+        return toString(put(key, value));
+    }
+
+    string find(int key) {
+        return toString(lookup(key));
+    }
+
+    string erase(int key) {
+        return toString(remove(key));
+    }
+
+    int size() const {
+        return cur.size + old.size;
+    }
+
+    int capacity() const {
+        return cur.capacity();
+    }
+
+    double loadFactor() const {
+        return (double)cur.used / cur.capacity();
+    }
+};
+
+#endif // HW5_HASH_TABLES_H
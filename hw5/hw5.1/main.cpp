@@ -2,161 +2,219 @@
 #include <vector>
 #include <string>
 #include <algorithm>
-
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include "hash_tables.h"
 using namespace std;
 
-class LinearProbingHashTable {
-private:
-    struct Entry {
-        int key;
-        string value;
-        bool inUse;     // 表示该桶当前是否有有效数据（未被删除）
-        bool neverUsed; // 表示该桶是否从未被使用过（包括未插入和未删除）
-    };
-
-    vector<Entry> table;
-    int capacity;
-    int size; // 当前有效数据个数（inUse=true 的桶数）
-
-    // 哈希函数
-    int hash(int key) {
-        return key % capacity;
+// 插入吞吐量：向容量为 capacity 的表插入 count 个随机 key，每插入 4 个删除 1 个
+void benchmarkInsert(int capacity, int count) {
+    mt19937 gen(2024);
+    vector<int> keys(count);
+    for (auto& k : keys) k = (int)(gen() & 0x7FFFFFFF);
+
+    LinearProbingHashTable ht(capacity);
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        ht.insert(keys[i], "v");
+        if (i % 4 == 3) ht.erase(keys[i - 2]);
     }
-
-    // 计算空桶中 neverUsed=false 的比例（用于触发重组织）
-    double getNeverUsedFalseRatio() {
-        int emptyCount = 0;          // 空桶总数（inUse=false 的桶）
-        int neverUsedFalseCount = 0; // 空桶中 neverUsed=false 的数量
-        for (const auto& entry : table) {
-            if (!entry.inUse) {
-                emptyCount++;
-                if (!entry.neverUsed) {
-                    neverUsedFalseCount++;
-                }
-            }
-        }
-        return emptyCount == 0 ? 0.0 : (double)neverUsedFalseCount / emptyCount;
+    auto t1 = chrono::steady_clock::now();
+    double us = chrono::duration<double, micro>(t1 - t0).count();
+    cout << "capacity " << capacity << ", " << count << " inserts: "
+         << count / us << " M inserts/s" << endl;
+}
+
+// 查找速度：字符串接口 find() 与零分配接口 lookup() 对比，命中与未命中各半
+void benchmarkLookup(int capacity, int count) {
+    LinearProbingHashTable ht(capacity);
+    for (int i = 0; i < count; ++i) ht.insert(i * 2, "value");
+    const int rounds = 4;
+
+    auto t0 = chrono::steady_clock::now();
+    size_t chars = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < count; ++i) chars += ht.find(i).size();
     }
-
-    // 重组织散列表：重新插入所有有效数据，空桶 neverUsed 设为 true
-    void reorganize() {
-        vector<Entry> oldTable = table;
-        // 重置新表：所有桶 neverUsed=true，inUse=false
-        table.assign(capacity, {0, "", false, true});
-        size = 0;
-
-        // 重新插入旧表中所有有效数据（inUse=true）
-        for (const auto& entry : oldTable) {
-            if (entry.inUse) {
-                insert(entry.key, entry.value, true); // 内部调用，跳过重组织检查
-            }
-        }
+    auto t1 = chrono::steady_clock::now();
+    size_t hits = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < count; ++i) hits += ht.lookup(i).status == HashStatus::Found;
     }
-
-    // 内部插入接口：skipReorganize=true 时跳过重组织检查（避免递归）
-    string insert(int key, const string& value, bool skipReorganize) {
-        if (!skipReorganize && getNeverUsedFalseRatio() >= 0.6) {
-            reorganize();
+    auto t2 = chrono::steady_clock::now();
+
+    double ops = (double)rounds * count;
+    cout << "find (string): " << ops / chrono::duration<double, micro>(t1 - t0).count() << " M lookups/s" << endl;
+    cout << "lookup (POD):  " << ops / chrono::duration<double, micro>(t2 - t1).count() << " M lookups/s" << endl;
+    cout << "(" << chars << " chars, " << hits << " hits)" << endl;
+}
+
+// 高频删除/插入：线性探查（墓碑 + 重组织）与 Robin Hood 的耗时，及 Robin Hood 的探查长度
+void benchmarkChurn(int capacity, int rounds) {
+    int live = (int)(capacity * 0.8);
+    mt19937 gen(7);
+    vector<int> keys(live);
+    for (auto& k : keys) k = (int)(gen() & 0x7FFFFFFF);
+
+    auto run = [&](auto& ht, const char* name) {
+        for (int k : keys) ht.put(k, "v");
+        auto t0 = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            int i = (int)(gen() % live);
+            ht.remove(keys[i]);
+            keys[i] = (int)(gen() & 0x7FFFFFFF);
+            ht.put(keys[i], "v");
+            ht.lookup((int)(gen() & 0x7FFFFFFF));
         }
+        auto t1 = chrono::steady_clock::now();
+        cout << name << ": " << rounds / chrono::duration<double, micro>(t1 - t0).count()
+             << " M rounds/s (erase + insert + miss)" << endl;
+    };
 
-        int index = hash(key);
-        int start = index;
-        int firstDeletedIndex = -1; // 记录第一个遇到的已删除桶（inUse=false）
-
-        do {
-            // 情况1：桶从未使用过（neverUsed=true）—— 直接插入
-            if (table[index].neverUsed) {
-                // 优先使用之前找到的已删除桶（如果有）
-                if (firstDeletedIndex != -1) {
-                    index = firstDeletedIndex;
-                }
-                table[index].key = key;
-                table[index].value = value;
-                table[index].inUse = true;
-                table[index].neverUsed = false;
-                size++;
-                return "{inserted, index:" + to_string(index) + "}";
+    vector<int> initial = keys;
+    LinearProbingHashTable linear(capacity);
+    run(linear, "linear probing");
+    keys = initial;
+    RobinHoodHashTable robin(capacity);
+    run(robin, "robin hood");
+    keys = initial;
+    SwissHashTable swiss(capacity);
+    run(swiss, "swiss table");
+    auto stats = robin.probeStats();
+    cout << "robin hood probe length: max " << stats.maxProbe << ", mean " << stats.meanProbe << endl;
+}
+
+// 多线程 90% 读 / 10% 写：分片读写锁与单把读写锁（1 个分片）的吞吐量对比
+template <int ShardBits>
+double shardedThroughput(int threads, int keys, long long opsPerThread) {
+    ShardedHashTable<int, string, hash<int>, equal_to<int>, ShardBits> ht(keys * 2);
+    for (int k = 0; k < keys; ++k) ht.put(k, "v");
+
+    atomic<bool> go(false);
+    atomic<size_t> sink(0);
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            mt19937 gen(t + 1);
+            size_t seen = 0;
+            while (!go.load(memory_order_acquire)) {
             }
-            // 情况2：桶已使用过（neverUsed=false）
-            else {
-                // 找到相同key，更新值
-                if (table[index].key == key) {
-                    table[index].value = value;
-                    return "{updated, index:" + to_string(index) + "}";
-                }
-                // 遇到已删除的桶，记录第一个位置（用于后续插入）
-                if (!table[index].inUse && firstDeletedIndex == -1) {
-                    firstDeletedIndex = index;
+            for (long long i = 0; i < opsPerThread; ++i) {
+                int key = (int)(gen() % keys);
+                if (gen() % 10 == 0) {
+                    ht.put(key, "w");
+                } else {
+                    ht.visit(key, [&seen](const string& v) { seen += v.size(); });
                 }
             }
-
-            index = (index + 1) % capacity;
-        } while (index != start);
-
-        // 循环结束：表满（无从未使用的桶，且无已删除的桶）
-        return "{full, index:" + to_string(start) + "}";
+            sink += seen;
+        });
     }
-
-public:
-    LinearProbingHashTable(int cap) : capacity(cap), size(0) {
-        table.assign(capacity, {0, "", false, true});
+    auto t0 = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto& th : pool) th.join();
+    auto t1 = chrono::steady_clock::now();
+    return threads * opsPerThread / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+void benchmarkConcurrent(int maxThreads, long long opsPerThread) {
+    const int keys = 1 << 16;
+    cout << "threads  sharded(16)(M ops/s)  single lock(M ops/s)" << endl;
+    for (int t = 1;; t = min(t * 2, maxThreads)) {
+        cout << t << "  " << shardedThroughput<4>(t, keys, opsPerThread) << "  "
+             << shardedThroughput<0>(t, keys, opsPerThread) << endl;
+        if (t == maxThreads) break;
     }
+}
 
-    // 外部插入接口
-    string insert(int key, const string& value) {
-        return insert(key, value, false);
+// 快照：建表、写文件、映射加载并查找，比较重放插入与映射加载的耗时
+void benchmarkSnapshot(int count, const string& path) {
+    auto ms = [](chrono::steady_clock::time_point a, chrono::steady_clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+    vector<int> keys(count);
+    mt19937 gen(99);
+    for (auto& k : keys) k = (int)(gen() & 0x7FFFFFFF);
+
+    auto t0 = chrono::steady_clock::now();
+    LinearProbingHashTable ht(count * 2);
+    for (int k : keys) ht.put(k, "value-" + to_string(k));
+    auto t1 = chrono::steady_clock::now();
+    if (!saveSnapshot(ht, path)) {
+        cout << "cannot write " << path << endl;
+        return;
     }
-
-    // 查找接口：返回探查终止时的索引（而非初始哈希索引）
-    string find(int key) {
-        int index = hash(key);
-        int start = index;
-        int finalIndex = start; // 记录探查终止时的索引
-
-        do {
-            finalIndex = index; // 更新当前探查索引为最终索引
-            // 桶从未使用过，无需继续探查（后续桶也不可能有目标key）
-            if (table[index].neverUsed) {
-                break;
-            }
-            // 找到目标key，返回结果
-            if (table[index].key == key && table[index].inUse) {
-                return "{found, index:" + to_string(index) + ", value:" + table[index].value + "}";
-            }
-
-            index = (index + 1) % capacity;
-        } while (index != start);
-
-        // 未找到：返回探查终止时的索引
-        return "{not_found, index:" + to_string(finalIndex) + "}";
+    auto t2 = chrono::steady_clock::now();
+    MappedHashTable mapped;
+    if (!mapped.open(path)) {
+        cout << "cannot load " << path << endl;
+        return;
+    }
+    auto t3 = chrono::steady_clock::now();
+    int mismatches = 0;
+    for (int k : keys) {
+        if (mapped.find(k) != ht.find(k)) mismatches++;
+    }
+    for (int i = 0; i < 1000; ++i) {
+        int k = (int)(gen() & 0x7FFFFFFF);
+        if (mapped.find(k) != ht.find(k)) mismatches++;
     }
 
-    // 删除接口：仅标记 inUse=false，不改变 neverUsed
-    string erase(int key) {
-        int index = hash(key);
-        int start = index;
+    cout << "build by inserts: " << ms(t0, t1) << " ms" << endl;
+    cout << "save: " << ms(t1, t2) << " ms" << endl;
+    cout << "load (mmap): " << ms(t2, t3) << " ms, " << mapped.size() << " entries, "
+         << mismatches << " mismatches" << endl;
+}
+
+// InlineString 的自检：内联、恰好 N 个字符、堆上三种长度的构造、拷贝、移动与清空
+template <size_t N>
+bool checkInlineString() {
+    bool ok = true;
+    for (size_t len : {(size_t)0, (size_t)1, N - 1, N, N + 1, 3 * N}) {
+        string s(len, 'y');
+        InlineString<N> a(s);
+        InlineString<N> b(a);
+        InlineString<N> c(std::move(b));
+        ok = ok && a.size() == len && a.view() == s && a.isInline() == (len <= N);
+        ok = ok && c == a && b.size() == 0 && c.data()[len] == '\0';
+        c.clear();
+        ok = ok && c.size() == 0 && c.isInline();
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "check") {
+        bool ok = checkInlineString<sizeof(char*) + sizeof(size_t)>() && checkInlineString<22>();
+        cout << "InlineString: " << (ok ? "OK" : "FAILED") << endl;
+        return ok ? 0 : 1;
+    }
 
-        do {
-            // 桶从未使用过，无需继续探查
-            if (table[index].neverUsed) {
-                break;
-            }
-            // 找到目标key且有效，标记为删除
-            if (table[index].key == key && table[index].inUse) {
-                table[index].inUse = false;
-                size--;
-                return "{removed, index:" + to_string(index) + "}";
-            }
+    if (argc > 1 && string(argv[1]) == "snapshot") {
+        int count = argc > 2 ? stoi(argv[2]) : 1000000;
+        benchmarkSnapshot(count, argc > 3 ? argv[3] : "table.snap");
+        return 0;
+    }
 
-            index = (index + 1) % capacity;
-        } while (index != start);
+    if (argc > 1 && string(argv[1]) == "bench-mt") {
+        int threads = argc > 2 ? stoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+        long long ops = argc > 3 ? stoll(argv[3]) : 1000000;
+        benchmarkConcurrent(threads, ops);
+        return 0;
+    }
 
-        // 未找到
-        return "{not_found, index:" + to_string(start) + "}";
+    if (argc > 1 && string(argv[1]) == "bench") {
+        int capacity = argc > 2 ? stoi(argv[2]) : 1000000;
+        int count = argc > 3 ? stoi(argv[3]) : capacity / 2;
+        benchmarkInsert(capacity, count);
+        benchmarkLookup(capacity, count);
+        benchmarkChurn(capacity, count);
+        return 0;
     }
-};
 
-int main() {
     LinearProbingHashTable ht(7);
 
     cout << ht.insert(1, "a") << endl;    // {inserted, index:1}
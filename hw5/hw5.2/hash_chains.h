@@ -0,0 +1,714 @@
+// 链式散列表：带尾哨兵的链表、分块链表与无锁读的并发链表，供 main.cpp 与 ../bench 共用
+#ifndef HW5_HASH_CHAINS_H
+#define HW5_HASH_CHAINS_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <new>
+#include <utility>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <functional>
+using namespace std;
+
+// 链表节点结构（包含尾哨兵所需的next指针）
+template <class K, class E>
+struct ChainNode {
+    K key;
+    E value;
+    ChainNode* next;
+
+    // 普通节点构造函数（默认指向尾哨兵）
+    ChainNode(const K& k, const E& v, ChainNode* n = nullptr) : key(k), value(v), next(n) {}
+    // 尾哨兵专用构造函数（无key/value，next指向自身）
+    ChainNode() : next(this) {}
+};
+
+// 节点池：按块（slab）申请内存，释放的节点挂到空闲链表上重复使用，插入删除不再每次调用 new/delete
+template <class Node>
+class NodePool {
+public:
+    NodePool() : freeList(nullptr), slabSize(16) {}
+
+    ~NodePool() {
+        for (Node* slab : slabs) {
+            ::operator delete(static_cast<void*>(slab));
+        }
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <class... Args>
+    Node* create(Args&&... args) {
+        if (freeList == nullptr) {
+            grow();
+        }
+        Node* n = freeList;
+        freeList = freeList->next;
+        return new (n) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node* n) {
+        n->~Node();
+        // 空闲节点借用 next 字段串成链表
+        n->next = freeList;
+        freeList = n;
+    }
+
+private:
+    // 新块大小翻倍，上限 4096 个节点
+    void grow() {
+        Node* slab = static_cast<Node*>(::operator new(slabSize * sizeof(Node)));
+        slabs.push_back(slab);
+        for (size_t i = 0; i < slabSize; ++i) {
+            slab[i].next = (i + 1 < slabSize) ? &slab[i + 1] : freeList;
+        }
+        freeList = slab;
+        if (slabSize < 4096) {
+            slabSize *= 2;
+        }
+    }
+
+    vector<Node*> slabs;
+    Node* freeList;
+    size_t slabSize;
+};
+
+// 直接使用 new/delete 的节点分配方式（与节点池对比用）
+template <class Node>
+class HeapNodes {
+public:
+    template <class... Args>
+    Node* create(Args&&... args) {
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node* n) {
+        delete n;
+    }
+};
+
+// 带尾哨兵的链式散列表，链表按 key 升序排列。
+// 平均链长超过 maxLoad 时桶数扩为 2 * divisor + 1，旧桶在之后的每次插入/删除中
+// 逐个迁移到新桶（渐进式 rehash），不会出现一次性整表重建的停顿。
+template <class K, class E, class Alloc = NodePool<ChainNode<K, E>>>
+class hashChainsWithTail {
+private:
+    ChainNode<K, E>** table;  // 散列表
+    int divisor;              // 桶数量
+    ChainNode<K, E>** oldTable; // 迁移中的旧散列表，未在迁移时为 nullptr
+    int oldDivisor;           // 旧表桶数量
+    int migrateIndex;         // 旧表中下一个待迁移的桶，之前的桶已迁移完
+    int count;                // 元素个数
+    double maxLoad;           // 平均链长上限
+    ChainNode<K, E> sentinel; // 本表自己的尾哨兵（next 指向自身）
+    ChainNode<K, E>* tail;    // 指向 sentinel
+    Alloc nodes;              // 节点分配
+
+    static const int MIGRATE_BUCKETS = 4; // 每次操作至少迁移的旧桶数
+
+    int hash(const K& k) const {
+        return k % divisor;
+    }
+
+    ChainNode<K, E>** newBuckets(int n) {
+        ChainNode<K, E>** t = new ChainNode<K, E>*[n];
+        // 所有空桶直接指向尾哨兵
+        for (int i = 0; i < n; ++i) {
+            t[i] = tail;
+        }
+        return t;
+    }
+
+    // k 所在的旧桶；不在迁移中或该桶已迁移时返回 -1
+    int oldBucket(const K& k) const {
+        if (oldTable == nullptr) {
+            return -1;
+        }
+        int b = k % oldDivisor;
+        return b >= migrateIndex ? b : -1;
+    }
+
+    // 把节点按升序接入当前表
+    void link(ChainNode<K, E>* node) {
+        ChainNode<K, E>** link = &table[hash(node->key)];
+        while (*link != tail && (*link)->key < node->key) {
+            link = &(*link)->next;
+        }
+        node->next = *link;
+        *link = node;
+    }
+
+    // 迁移若干个旧桶；空桶不计入 MIGRATE_BUCKETS，但每次最多扫描 16 个
+    void migrate() {
+        int moved = 0;
+        for (int scanned = 0; oldTable != nullptr && moved < MIGRATE_BUCKETS && scanned < 16; ++scanned) {
+            ChainNode<K, E>* cur = oldTable[migrateIndex];
+            if (cur != tail) {
+                moved++;
+            }
+            while (cur != tail) {
+                ChainNode<K, E>* next = cur->next;
+                link(cur);
+                cur = next;
+            }
+            if (++migrateIndex == oldDivisor) {
+                delete[] oldTable;
+                oldTable = nullptr;
+            }
+        }
+    }
+
+    // 插入前检查负载，超过上限时开始一轮渐进式 rehash
+    void reserveOne() {
+        if (oldTable != nullptr || count + 1 <= maxLoad * divisor) {
+            return;
+        }
+        oldTable = table;
+        oldDivisor = divisor;
+        migrateIndex = 0;
+        divisor = divisor * 2 + 1;
+        table = newBuckets(divisor);
+    }
+
+    void freeChains(ChainNode<K, E>** t, int from, int to) {
+        for (int i = from; i < to; ++i) {
+            ChainNode<K, E>* cur = t[i];
+            while (cur != tail) {
+                ChainNode<K, E>* temp = cur;
+                cur = cur->next;
+                nodes.destroy(temp);
+            }
+        }
+    }
+
+    static bool chainEndsAtTail(ChainNode<K, E>* cur, ChainNode<K, E>* tail) {
+        // 遍历到链表最后一个节点（next为尾哨兵）
+        while (cur->next != tail) {
+            // 防止死循环（若链表成环，此处会无限循环，需额外处理，但按题意不会出现）
+            cur = cur->next;
+        }
+        // 确认最后一个节点的next是尾哨兵
+        return cur->next == tail;
+    }
+
+public:
+    hashChainsWithTail(int cap, double maxLoadFactor = 1.0)
+        : divisor(cap), oldTable(nullptr), oldDivisor(0), migrateIndex(0), count(0),
+          maxLoad(maxLoadFactor), tail(&sentinel) {
+        table = newBuckets(divisor);
+    }
+
+    // 尾哨兵地址属于本表，不可复制
+    hashChainsWithTail(const hashChainsWithTail&) = delete;
+    hashChainsWithTail& operator=(const hashChainsWithTail&) = delete;
+
+    ~hashChainsWithTail() {
+        freeChains(table, 0, divisor);
+        delete[] table;
+        if (oldTable != nullptr) {
+            freeChains(oldTable, migrateIndex, oldDivisor);
+            delete[] oldTable;
+        }
+    }
+
+    pair<string, pair<int, int>> insert(const K& k, const E& v) {
+        migrate();
+        reserveOne();
+
+        // 尚未迁移的旧桶里可能已有该 key
+        int ob = oldBucket(k);
+        if (ob >= 0) {
+            int pos = 0;
+            for (ChainNode<K, E>* cur = oldTable[ob]; cur != tail && !(k < cur->key); cur = cur->next, pos++) {
+                if (cur->key == k) {
+                    return {"exists", {ob, pos}};
+                }
+            }
+        }
+
+        int b = hash(k);
+        ChainNode<K, E>* prev = nullptr;
+        ChainNode<K, E>* cur = table[b];
+        int pos = 0;
+
+        while (cur != tail && cur->key < k) {
+            prev = cur;
+            cur = cur->next;
+            pos++;
+        }
+
+        if (cur != tail && cur->key == k) {
+            return {"exists", {b, pos}};
+        }
+
+        ChainNode<K, E>* newNode = nodes.create(k, v, cur);
+        if (prev == nullptr) {
+            table[b] = newNode;
+        } else {
+            prev->next = newNode;
+        }
+        count++;
+        return {"inserted", {b, pos}};
+    }
+
+    pair<string, pair<int, int>> find(const K& k) const {
+        int b = hash(k);
+        ChainNode<K, E>* cur = table[b];
+        int pos = 0;
+
+        while (cur != tail && cur->key != k) {
+            cur = cur->next;
+            pos++;
+        }
+
+        if (cur != tail && cur->key == k) {
+            return {"found", {b, pos}};
+        }
+
+        int ob = oldBucket(k);
+        if (ob >= 0) {
+            pos = 0;
+            for (cur = oldTable[ob]; cur != tail; cur = cur->next, pos++) {
+                if (cur->key == k) {
+                    return {"found", {ob, pos}};
+                }
+            }
+        }
+        return {"not_found", {b, -1}};
+    }
+
+    pair<string, int> erase(const K& k) {
+        migrate();
+
+        int b = hash(k);
+        ChainNode<K, E>** buckets = table;
+        int ob = oldBucket(k);
+        for (int pass = 0; pass < 2; ++pass) {
+            ChainNode<K, E>* prev = nullptr;
+            ChainNode<K, E>* cur = buckets[b];
+
+            while (cur != tail && cur->key != k) {
+                prev = cur;
+                cur = cur->next;
+            }
+
+            if (cur != tail && cur->key == k) {
+                if (prev == nullptr) {
+                    buckets[b] = cur->next;
+                } else {
+                    prev->next = cur->next;
+                }
+                nodes.destroy(cur);
+                count--;
+                return {"removed", b};
+            }
+
+            // 新表中没有：再查尚未迁移的旧桶
+            if (ob < 0) {
+                break;
+            }
+            buckets = oldTable;
+            b = ob;
+        }
+        return {"not_found", hash(k)};
+    }
+
+    int size() const {
+        return count;
+    }
+
+    int bucketCount() const {
+        return divisor;
+    }
+
+    bool rehashing() const {
+        return oldTable != nullptr;
+    }
+
+    // 修复尾哨兵检查逻辑
+    bool checkTailSentinel() const {
+        // 1. 检查尾哨兵自身的next是否指向自己
+        if (tail->next != tail) {
+            return false;
+        }
+
+        // 2. 检查每个桶（包括尚未迁移的旧桶）的链表末尾是否指向尾哨兵
+        for (int i = 0; i < divisor; ++i) {
+            if (!chainEndsAtTail(table[i], tail)) {
+                return false;
+            }
+        }
+        for (int i = migrateIndex; oldTable != nullptr && i < oldDivisor; ++i) {
+            if (!chainEndsAtTail(oldTable[i], tail)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+// 分块链式散列表：每个桶是一个可容纳 S 个 (key, value) 的连续块，满了才链出溢出块。
+// 整条链（块内与块间）保持 key 升序，查找仍可在遇到更大的 key 时提前结束，
+// 但每次指针跳转能比较 S 个 key，高负载下比逐节点遍历更省缓存。
+template <class K, class E, int S = 6>
+class hashBlockChains {
+private:
+    struct Block {
+        int n;       // 已用槽数
+        K keys[S];   // key 与 value 分开存放，比较 key 时不读 value
+        E values[S];
+        Block* next; // 溢出块，没有时为 nullptr
+
+        Block() : n(0), next(nullptr) {}
+    };
+
+    Block* table; // 每个桶的首块
+    int divisor;  // 桶数量
+    NodePool<Block> pool; // 溢出块分配
+
+    int hash(const K& k) const {
+        return k % divisor;
+    }
+
+    // 块内插入到第 i 个槽（调用前块未满）
+    static void insertAt(Block* blk, int i, const K& k, const E& v) {
+        for (int j = blk->n; j > i; --j) {
+            blk->keys[j] = std::move(blk->keys[j - 1]);
+            blk->values[j] = std::move(blk->values[j - 1]);
+        }
+        blk->keys[i] = k;
+        blk->values[i] = v;
+        blk->n++;
+    }
+
+    // 块已满：后一半移到新的溢出块
+    void split(Block* blk) {
+        Block* right = pool.create();
+        int half = S / 2;
+        for (int j = half; j < S; ++j) {
+            right->keys[j - half] = std::move(blk->keys[j]);
+            right->values[j - half] = std::move(blk->values[j]);
+        }
+        right->n = S - half;
+        blk->n = half;
+        right->next = blk->next;
+        blk->next = right;
+    }
+
+public:
+    hashBlockChains(int cap) : divisor(cap) {
+        table = new Block[divisor];
+    }
+
+    hashBlockChains(const hashBlockChains&) = delete;
+    hashBlockChains& operator=(const hashBlockChains&) = delete;
+
+    ~hashBlockChains() {
+        for (int i = 0; i < divisor; ++i) {
+            Block* cur = table[i].next;
+            while (cur != nullptr) {
+                Block* temp = cur;
+                cur = cur->next;
+                pool.destroy(temp);
+            }
+        }
+        delete[] table;
+    }
+
+    pair<string, pair<int, int>> insert(const K& k, const E& v) {
+        int b = hash(k);
+        Block* blk = &table[b];
+        int pos = 0;
+
+        for (;;) {
+            int i = 0;
+            while (i < blk->n && blk->keys[i] < k) {
+                i++;
+            }
+            if (i < blk->n && blk->keys[i] == k) {
+                return {"exists", {b, pos + i}};
+            }
+            // 比本块所有 key 都大，且下一块的首个 key 不大于 k：到下一块找位置
+            if (i == blk->n && blk->next != nullptr && !(k < blk->next->keys[0])) {
+                pos += blk->n;
+                blk = blk->next;
+                continue;
+            }
+
+            if (blk->n == S) {
+                split(blk);
+                if (i > blk->n) {
+                    pos += blk->n;
+                    i -= blk->n;
+                    blk = blk->next;
+                }
+            }
+            insertAt(blk, i, k, v);
+            return {"inserted", {b, pos + i}};
+        }
+    }
+
+    pair<string, pair<int, int>> find(const K& k) const {
+        int b = hash(k);
+        int pos = 0;
+
+        for (const Block* blk = &table[b]; blk != nullptr; blk = blk->next) {
+            for (int i = 0; i < blk->n; ++i) {
+                if (!(blk->keys[i] < k)) {
+                    if (blk->keys[i] == k) {
+                        return {"found", {b, pos + i}};
+                    }
+                    return {"not_found", {b, -1}}; // 升序：后面的 key 都更大
+                }
+            }
+            pos += blk->n;
+        }
+        return {"not_found", {b, -1}};
+    }
+
+    pair<string, int> erase(const K& k) {
+        int b = hash(k);
+        Block* prev = nullptr;
+
+        for (Block* blk = &table[b]; blk != nullptr; prev = blk, blk = blk->next) {
+            int i = 0;
+            while (i < blk->n && blk->keys[i] < k) {
+                i++;
+            }
+            if (i == blk->n) {
+                continue;
+            }
+            if (!(blk->keys[i] == k)) {
+                break;
+            }
+
+            for (int j = i + 1; j < blk->n; ++j) {
+                blk->keys[j - 1] = std::move(blk->keys[j]);
+                blk->values[j - 1] = std::move(blk->values[j]);
+            }
+            blk->n--;
+            blk->values[blk->n] = E();
+
+            // 溢出块不留空块：空的溢出块直接摘除，空的首块把下一块搬进来
+            if (blk->n == 0 && blk->next != nullptr && prev == nullptr) {
+                Block* next = blk->next;
+                for (int j = 0; j < next->n; ++j) {
+                    blk->keys[j] = std::move(next->keys[j]);
+                    blk->values[j] = std::move(next->values[j]);
+                }
+                blk->n = next->n;
+                blk->next = next->next;
+                pool.destroy(next);
+            } else if (blk->n == 0 && prev != nullptr) {
+                prev->next = blk->next;
+                pool.destroy(blk);
+            }
+            return {"removed", b};
+        }
+        return {"not_found", b};
+    }
+};
+
+// 读操作无锁的链式散列表（读多写少场景）。
+// 链表结构与 hashChainsWithTail 相同（尾哨兵、key 升序）；写操作之间用互斥锁串行，
+// 新节点填好后用 release 写入前驱的 next 发布，读者用 acquire 读取 next 遍历，不加锁。
+// 删除的节点先放入待回收列表，等所有在此之前开始的读者都结束（两次翻转读者纪元）后再释放。
+// 桶数固定，不做 rehash。
+template <class K, class E>
+class concurrentHashChains {
+private:
+    struct Node {
+        K key;
+        E value;
+        atomic<Node*> next;
+
+        Node(const K& k, const E& v, Node* n) : key(k), value(v), next(n) {}
+        Node() : next(this) {}
+    };
+
+    static const int STRIPES = 16;     // 读者计数分散到多条缓存行
+    static const size_t RETIRE_BATCH = 64; // 待回收节点攒够后统一等待宽限期
+
+    struct alignas(64) ReaderCount {
+        atomic<long> n{0};
+    };
+
+    atomic<Node*>* table; // 散列表
+    int divisor;          // 桶数量
+    Node sentinel;        // 尾哨兵
+    Node* tail;
+    mutex writeLock;
+    vector<Node*> retired; // 已摘除、等待宽限期结束的节点（持 writeLock 访问）
+    atomic<unsigned long> epoch;
+    mutable ReaderCount readers[2][STRIPES]; // readers[纪元奇偶][分片]
+
+    int hash(const K& k) const {
+        return k % divisor;
+    }
+
+    static int stripe() {
+        static thread_local int s = (int)(std::hash<thread::id>()(this_thread::get_id()) % STRIPES);
+        return s;
+    }
+
+    // 读者进入：登记到当前纪元；若登记期间纪元已翻转则重新登记
+    unsigned long readLock() const {
+        for (;;) {
+            unsigned long e = epoch.load();
+            readers[e & 1][stripe()].n.fetch_add(1);
+            if (epoch.load() == e) {
+                return e;
+            }
+            readers[e & 1][stripe()].n.fetch_sub(1);
+        }
+    }
+
+    void readUnlock(unsigned long e) const {
+        readers[e & 1][stripe()].n.fetch_sub(1, memory_order_release);
+    }
+
+    // 宽限期：翻转两次纪元，每次等待旧纪元的读者全部离开。
+    // 这里与 readLock 是"先写后读对方"的握手，计数的读取必须是 seq_cst，
+    // 否则可能读到 0 而读者仍看到旧纪元（acquire 不能阻止先前的写与之后的读重排）
+    void synchronize() {
+        for (int phase = 0; phase < 2; ++phase) {
+            unsigned long old = epoch.fetch_add(1);
+            for (int i = 0; i < STRIPES; ++i) {
+                while (readers[old & 1][i].n.load() != 0) {
+                    this_thread::yield();
+                }
+            }
+        }
+    }
+
+    void reclaim() {
+        synchronize();
+        for (Node* n : retired) {
+            delete n;
+        }
+        retired.clear();
+    }
+
+    struct ReadGuard {
+        const concurrentHashChains* table;
+        unsigned long e;
+
+        explicit ReadGuard(const concurrentHashChains* t) : table(t), e(t->readLock()) {}
+        ~ReadGuard() { table->readUnlock(e); }
+    };
+
+public:
+    concurrentHashChains(int cap) : divisor(cap), tail(&sentinel), epoch(0) {
+        table = new atomic<Node*>[divisor];
+        // 所有空桶直接指向尾哨兵
+        for (int i = 0; i < divisor; ++i) {
+            table[i].store(tail, memory_order_relaxed);
+        }
+    }
+
+    concurrentHashChains(const concurrentHashChains&) = delete;
+    concurrentHashChains& operator=(const concurrentHashChains&) = delete;
+
+    // 析构时不能再有并发读者
+    ~concurrentHashChains() {
+        for (int i = 0; i < divisor; ++i) {
+            Node* cur = table[i].load(memory_order_relaxed);
+            while (cur != tail) {
+                Node* temp = cur;
+                cur = cur->next.load(memory_order_relaxed);
+                delete temp;
+            }
+        }
+        for (Node* n : retired) {
+            delete n;
+        }
+        delete[] table;
+    }
+
+    pair<string, pair<int, int>> insert(const K& k, const E& v) {
+        lock_guard<mutex> guard(writeLock);
+        int b = hash(k);
+        atomic<Node*>* link = &table[b];
+        Node* cur = link->load(memory_order_relaxed);
+        int pos = 0;
+
+        while (cur != tail && cur->key < k) {
+            link = &cur->next;
+            cur = link->load(memory_order_relaxed);
+            pos++;
+        }
+
+        if (cur != tail && cur->key == k) {
+            return {"exists", {b, pos}};
+        }
+
+        // 节点内容写完后再发布，读者看到指针时一定能看到完整的 key/value
+        link->store(new Node(k, v, cur), memory_order_release);
+        return {"inserted", {b, pos}};
+    }
+
+    pair<string, pair<int, int>> find(const K& k) const {
+        ReadGuard guard(this);
+        int b = hash(k);
+        Node* cur = table[b].load(memory_order_acquire);
+        int pos = 0;
+
+        while (cur != tail && cur->key < k) {
+            cur = cur->next.load(memory_order_acquire);
+            pos++;
+        }
+
+        if (cur != tail && cur->key == k) {
+            return {"found", {b, pos}};
+        } else {
+            return {"not_found", {b, -1}};
+        }
+    }
+
+    // 找到时把值拷贝到 out
+    bool get(const K& k, E& out) const {
+        ReadGuard guard(this);
+        Node* cur = table[hash(k)].load(memory_order_acquire);
+        while (cur != tail && cur->key < k) {
+            cur = cur->next.load(memory_order_acquire);
+        }
+        if (cur != tail && cur->key == k) {
+            out = cur->value;
+            return true;
+        }
+        return false;
+    }
+
+    pair<string, int> erase(const K& k) {
+        lock_guard<mutex> guard(writeLock);
+        int b = hash(k);
+        atomic<Node*>* link = &table[b];
+        Node* cur = link->load(memory_order_relaxed);
+
+        while (cur != tail && cur->key < k) {
+            link = &cur->next;
+            cur = link->load(memory_order_relaxed);
+        }
+
+        if (cur == tail || cur->key != k) {
+            return {"not_found", b};
+        }
+
+        // 摘除后正在遍历 cur 的读者仍可沿 cur->next 继续走，因此 cur 暂不释放
+        link->store(cur->next.load(memory_order_relaxed), memory_order_release);
+        retired.push_back(cur);
+        if (retired.size() >= RETIRE_BATCH) {
+            reclaim();
+        }
+        return {"removed", b};
+    }
+};
+
+#endif // HW5_HASH_CHAINS_H
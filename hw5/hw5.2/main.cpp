@@ -1,146 +1,15 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include "hash_chains.h"
 using namespace std;
 
-// 链表节点结构（包含尾哨兵所需的next指针）
-template <class K, class E>
-struct ChainNode {
-    K key;
-    E value;
-    ChainNode* next;
-
-    // 普通节点构造函数（默认指向尾哨兵）
-    ChainNode(const K& k, const E& v, ChainNode* n = nullptr) : key(k), value(v), next(n) {}
-    // 尾哨兵专用构造函数（无key/value，next指向自身）
-    ChainNode() : next(this) {}
-};
-
-// 全局尾哨兵（单例，所有链表共享）
-ChainNode<int, string> T; // 直接用ChainNode实例作为尾哨兵，避免类型转换问题
-
-template <class K, class E>
-class hashChainsWithTail {
-private:
-    ChainNode<K, E>** table; // 散列表
-    int divisor;             // 桶数量
-    ChainNode<K, E>* tail;   // 指向全局尾哨兵（类型匹配）
-
-    int hash(const K& k) const {
-        return k % divisor;
-    }
-
-public:
-    hashChainsWithTail(int cap) : divisor(cap) {
-        table = new ChainNode<K, E>*[divisor];
-        // 所有空桶直接指向尾哨兵
-        for (int i = 0; i < divisor; ++i) {
-            table[i] = reinterpret_cast<ChainNode<K, E>*>(&T);
-        }
-        tail = reinterpret_cast<ChainNode<K, E>*>(&T);
-    }
-
-    ~hashChainsWithTail() {
-        for (int i = 0; i < divisor; ++i) {
-            ChainNode<K, E>* cur = table[i];
-            while (cur != tail) {
-                ChainNode<K, E>* temp = cur;
-                cur = cur->next;
-                delete temp;
-            }
-        }
-        delete[] table;
-    }
-
-    pair<string, pair<int, int>> insert(const K& k, const E& v) {
-        int b = hash(k);
-        ChainNode<K, E>* prev = nullptr;
-        ChainNode<K, E>* cur = table[b];
-        int pos = 0;
-
-        while (cur != tail && cur->key < k) {
-            prev = cur;
-            cur = cur->next;
-            pos++;
-        }
-
-        if (cur != tail && cur->key == k) {
-            return {"exists", {b, pos}};
-        }
-
-        ChainNode<K, E>* newNode = new ChainNode<K, E>(k, v, cur);
-        if (prev == nullptr) {
-            table[b] = newNode;
-        } else {
-            prev->next = newNode;
-        }
-        return {"inserted", {b, pos}};
-    }
-
-    pair<string, pair<int, int>> find(const K& k) const {
-        int b = hash(k);
-        ChainNode<K, E>* cur = table[b];
-        int pos = 0;
-
-        while (cur != tail && cur->key != k) {
-            cur = cur->next;
-            pos++;
-        }
-
-        if (cur != tail && cur->key == k) {
-            return {"found", {b, pos}};
-        } else {
-            return {"not_found", {b, -1}};
-        }
-    }
-
-    pair<string, int> erase(const K& k) {
-        int b = hash(k);
-        ChainNode<K, E>* prev = nullptr;
-        ChainNode<K, E>* cur = table[b];
-
-        while (cur != tail && cur->key != k) {
-            prev = cur;
-            cur = cur->next;
-        }
-
-        if (cur == tail || cur->key != k) {
-            return {"not_found", b};
-        }
-
-        if (prev == nullptr) {
-            table[b] = cur->next;
-        } else {
-            prev->next = cur->next;
-        }
-        delete cur;
-        return {"removed", b};
-    }
-
-    // 修复尾哨兵检查逻辑
-    bool checkTailSentinel() const {
-        // 1. 检查尾哨兵自身的next是否指向自己
-        if (T.next != &T) {
-            return false;
-        }
-
-        // 2. 检查每个桶的链表末尾是否指向尾哨兵
-        for (int i = 0; i < divisor; ++i) {
-            ChainNode<K, E>* cur = table[i];
-            // 遍历到链表最后一个节点（next为尾哨兵）
-            while (cur->next != tail) {
-                // 防止死循环（若链表成环，此处会无限循环，需额外处理，但按题意不会出现）
-                cur = cur->next;
-            }
-            // 确认最后一个节点的next是尾哨兵
-            if (cur->next != tail) {
-                return false;
-            }
-        }
-
-        return true;
-    }
-};
-
 void test() {
     hashChainsWithTail<int, string> hc(5);
 
@@ -177,7 +46,171 @@ void test() {
     cout <<  (tailCheck ? "pass" : "not pass") << endl;
 }
 
-int main() {
+// 高频插入/删除：节点池与直接 new/delete 的吞吐量对比
+template <class Table>
+double churnThroughput(int buckets, int live, int rounds) {
+    Table hc(buckets);
+    mt19937 gen(5);
+    vector<int> keys(live);
+    for (int i = 0; i < live; ++i) {
+        keys[i] = (int)(gen() & 0x7FFFFFFF);
+        hc.insert(keys[i], "value");
+    }
+    auto t0 = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        int i = (int)(gen() % live);
+        hc.erase(keys[i]);
+        keys[i] = (int)(gen() & 0x7FFFFFFF);
+        hc.insert(keys[i], "value");
+    }
+    auto t1 = chrono::steady_clock::now();
+    return rounds / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+void benchmarkChurn(int buckets, int live, int rounds) {
+    cout << "buckets " << buckets << ", live " << live << ", " << rounds << " erase+insert rounds" << endl;
+    cout << "node pool: " << churnThroughput<hashChainsWithTail<int, string>>(buckets, live, rounds)
+         << " M rounds/s" << endl;
+    cout << "new/delete: "
+         << churnThroughput<hashChainsWithTail<int, string, HeapNodes<ChainNode<int, string>>>>(buckets, live, rounds)
+         << " M rounds/s" << endl;
+}
+
+volatile int benchmarkSink; // 写入基准结果，防止查找被优化掉
+
+// 高负载查找：逐节点链表与分块链表的查找吞吐量（一半命中一半未命中）
+template <class Table>
+double lookupThroughput(Table& hc, const vector<int>& probes) {
+    auto t0 = chrono::steady_clock::now();
+    int hits = 0;
+    for (int k : probes) {
+        hits += hc.find(k).second.second >= 0;
+    }
+    auto t1 = chrono::steady_clock::now();
+    benchmarkSink = hits;
+    return probes.size() / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+void benchmarkLookup(int buckets) {
+    cout << "load  node chains(M lookups/s)  block chains(M lookups/s)" << endl;
+    for (int load : {1, 2, 4, 8, 16}) {
+        mt19937 gen(load);
+        vector<int> keys(buckets * load), probes;
+        for (auto& k : keys) {
+            k = (int)(gen() & 0x7FFFFFFF);
+        }
+        // 不扩容，保持指定的平均链长
+        hashChainsWithTail<int, string> chains(buckets, 1e9);
+        hashBlockChains<int, string> blocks(buckets);
+        for (int k : keys) {
+            chains.insert(k, "value");
+            blocks.insert(k, "value");
+        }
+        for (size_t i = 0; i < keys.size() && probes.size() < 1000000; ++i) {
+            probes.push_back(keys[i]);
+            probes.push_back((int)(gen() & 0x7FFFFFFF));
+        }
+        cout << load << "  " << lookupThroughput(chains, probes) << "  " << lookupThroughput(blocks, probes) << endl;
+    }
+}
+
+// hashChainsWithTail 加一把互斥锁，作为并发读的对照
+class LockedChains {
+public:
+    explicit LockedChains(int cap) : table(cap, 1e9) {}
+
+    pair<string, pair<int, int>> insert(int k, const string& v) {
+        lock_guard<mutex> guard(lock);
+        return table.insert(k, v);
+    }
+
+    pair<string, pair<int, int>> find(int k) {
+        lock_guard<mutex> guard(lock);
+        return table.find(k);
+    }
+
+    pair<string, int> erase(int k) {
+        lock_guard<mutex> guard(lock);
+        return table.erase(k);
+    }
+
+private:
+    mutex lock;
+    hashChainsWithTail<int, string> table;
+};
+
+// readers 个线程持续查找，另有 1 个线程持续删除再插入；返回读吞吐量（M 次/秒）
+template <class Table>
+double readScaling(int readers, int keys, long long readsPerThread) {
+    Table hc(keys);
+    for (int k = 0; k < keys; ++k) {
+        hc.insert(k, "value");
+    }
+    atomic<bool> go(false), done(false);
+    atomic<long long> sink(0);
+    thread writer([&] {
+        mt19937 gen(42);
+        while (!go.load()) {
+        }
+        while (!done.load(memory_order_relaxed)) {
+            int k = (int)(gen() % keys);
+            hc.erase(k);
+            hc.insert(k, "value");
+        }
+    });
+    vector<thread> pool;
+    for (int t = 0; t < readers; ++t) {
+        pool.emplace_back([&, t] {
+            mt19937 gen(t + 1);
+            long long hits = 0;
+            while (!go.load()) {
+            }
+            for (long long i = 0; i < readsPerThread; ++i) {
+                hits += hc.find((int)(gen() % keys)).second.second >= 0;
+            }
+            sink += hits;
+        });
+    }
+    auto t0 = chrono::steady_clock::now();
+    go.store(true);
+    for (auto& th : pool) {
+        th.join();
+    }
+    auto t1 = chrono::steady_clock::now();
+    done.store(true);
+    writer.join();
+    return readers * readsPerThread / chrono::duration<double, micro>(t1 - t0).count();
+}
+
+void benchmarkConcurrent(int maxReaders, long long reads) {
+    const int keys = 1 << 16;
+    cout << "readers  lock-free reads(M/s)  mutex(M/s)" << endl;
+    for (int t = 1;; t = min(t * 2, maxReaders)) {
+        cout << t << "  " << readScaling<concurrentHashChains<int, string>>(t, keys, reads) << "  "
+             << readScaling<LockedChains>(t, keys, reads) << endl;
+        if (t == maxReaders) {
+            break;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench-mt") {
+        int readers = argc > 2 ? stoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+        long long reads = argc > 3 ? stoll(argv[3]) : 1000000;
+        benchmarkConcurrent(readers, reads);
+        return 0;
+    }
+
+    if (argc > 1 && string(argv[1]) == "bench") {
+        int buckets = argc > 2 ? stoi(argv[2]) : 100003;
+        int live = argc > 3 ? stoi(argv[3]) : 200000;
+        int rounds = argc > 4 ? stoi(argv[4]) : 2000000;
+        benchmarkChurn(buckets, live, rounds);
+        benchmarkLookup(buckets);
+        return 0;
+    }
+
     test();
     return 0;
 }
\ No newline at end of file
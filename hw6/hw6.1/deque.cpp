@@ -1,39 +1,57 @@
 #include <bits/stdc++.h>
+#ifdef __linux__
+#include <pthread.h>
+#endif
 using namespace std;
 
-const int MAXN = 3;          // 默认容量为 3
+const int MAXN = 3;          // 命令文件解释器默认的容量上限
 
+// 环形数组双端队列：容量总是 2 的幂，下标用 & mask 回绕；
+// 装满时容量翻倍并把元素按从左到右的顺序搬到新数组开头。
+// limit 为 0 表示不限容量，否则元素个数达到 limit 时 IsFull 为真、Add 失败。
+template <class T>
 struct Deque {
-    int a[MAXN];
-    int L, R;                // L 指向真实左端，R 指向真实右端
-    int cnt;                 // 当前元素个数
+    vector<T> a;
+    size_t mask;
+    size_t L, R;             // L 指向真实左端，R 指向真实右端
+    size_t cnt;              // 当前元素个数
+    size_t limit;
 
-    Deque() { Create(); }
+    // 总是从小容量开始，由 Grow 翻倍；limit 只在 IsFull 中限制元素个数
+    explicit Deque(size_t maxSize = 0) : a(4), mask(3), limit(maxSize) {
+        Create();
+    }
 
     void Create() {
         L = 0;
-        R = -1;              // 初始置为空
+        R = mask;            // 初始置为空（R 在 L 左边一格）
         cnt = 0;
     }
 
     bool IsEmpty() const { return cnt == 0; }
-    bool IsFull()  const { return cnt == MAXN; }
+    bool IsFull()  const { return limit != 0 && cnt == limit; }
+    size_t Size() const { return cnt; }
+    size_t Capacity() const { return a.size(); }
 
-    int Left()  const { return IsEmpty() ? -1 : a[L]; }
-    int Right() const { return IsEmpty() ? -1 : a[R]; }
+    // 调用前须保证非空
+    const T& Left()  const { return a[L]; }
+    const T& Right() const { return a[R]; }
+    const T& operator[](size_t i) const { return a[(L + i) & mask]; }
 
-    bool AddLeft(int x) {
+    bool AddLeft(const T& x) {
         if (IsFull()) return false;
-        L = (L - 1 + MAXN) % MAXN;
+        if (cnt == a.size()) Grow();
+        L = (L - 1) & mask;
         a[L] = x;
         ++cnt;
         if (cnt == 1) R = L; // 第一个元素
         return true;
     }
 
-    bool AddRight(int x) {
+    bool AddRight(const T& x) {
         if (IsFull()) return false;
-        R = (R + 1) % MAXN;
+        if (cnt == a.size()) Grow();
+        R = (R + 1) & mask;
         a[R] = x;
         ++cnt;
         if (cnt == 1) L = R;
@@ -42,43 +60,213 @@ struct Deque {
 
     bool DeleteLeft() {
         if (IsEmpty()) return false;
-        L = (L + 1) % MAXN;
+        L = (L + 1) & mask;
         --cnt;
         return true;
     }
 
     bool DeleteRight() {
         if (IsEmpty()) return false;
-        R = (R - 1 + MAXN) % MAXN;
+        R = (R - 1) & mask;
         --cnt;
         return true;
     }
 
     // 按题意从左到右输出，元素间空格，行末无空格
     void Print() const {
-        if (IsEmpty()) {
-            cout << '\n';
-            return;
-        }
-        for (int i = 0, p = L; i < cnt; ++i, p = (p + 1) % MAXN) {
+        for (size_t i = 0, p = L; i < cnt; ++i, p = (p + 1) & mask) {
             if (i) cout << ' ';
             cout << a[p];
         }
         cout << '\n';
     }
+
+private:
+    // 容量翻倍，元素重新排到 [0, cnt)
+    void Grow() {
+        vector<T> b(a.size() * 2);
+        for (size_t i = 0, p = L; i < cnt; ++i, p = (p + 1) & mask) {
+            b[i] = std::move(a[p]);
+        }
+        a.swap(b);
+        mask = a.size() - 1;
+        L = 0;
+        R = (cnt - 1) & mask;
+    }
+};
+
+// 单生产者/单消费者无锁环形队列：生产者只在右端 AddRight，消费者只在左端 DeleteLeft。
+// L、R 是只增不减的计数，元素个数 cnt = R - L，下标为 & mask；
+// 两者各占一条缓存行，各自只由一个线程写入，另一方用 acquire 读取。
+// 每一方还缓存一份对方的计数，只有看起来满/空时才重新读取，减少缓存行来回传递。
+template <class T>
+class SpscDeque {
+public:
+    explicit SpscDeque(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        a.resize(cap);
+        mask = cap - 1;
+    }
+
+    SpscDeque(const SpscDeque&) = delete;
+    SpscDeque& operator=(const SpscDeque&) = delete;
+
+    size_t Capacity() const { return a.size(); }
+
+    // 仅生产者调用：最多放入 n 个，返回实际放入的个数
+    size_t AddRight(const T* src, size_t n) {
+        size_t r = R.load(memory_order_relaxed);
+        if (a.size() - (r - cachedL) < n) {
+            cachedL = L.load(memory_order_acquire);
+        }
+        size_t room = a.size() - (r - cachedL);
+        if (n > room) n = room;
+        for (size_t i = 0; i < n; ++i) {
+            a[(r + i) & mask] = src[i];
+        }
+        if (n) R.store(r + n, memory_order_release);
+        return n;
+    }
+
+    bool AddRight(const T& x) { return AddRight(&x, 1) == 1; }
+
+    // 仅消费者调用：最多取出 n 个到 dst，返回实际取出的个数
+    size_t DeleteLeft(T* dst, size_t n) {
+        size_t l = L.load(memory_order_relaxed);
+        if (cachedR - l < n) {
+            cachedR = R.load(memory_order_acquire);
+        }
+        size_t avail = cachedR - l;
+        if (n > avail) n = avail;
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = std::move(a[(l + i) & mask]);
+        }
+        if (n) L.store(l + n, memory_order_release);
+        return n;
+    }
+
+    bool DeleteLeft(T& x) { return DeleteLeft(&x, 1) == 1; }
+
+    // 另一方同时在操作时只是近似值
+    bool IsEmpty() const { return R.load(memory_order_acquire) == L.load(memory_order_acquire); }
+
+private:
+    vector<T> a;
+    size_t mask;
+    alignas(64) atomic<size_t> R{0};   // 生产者写
+    size_t cachedL = 0;                // 生产者看到的 L
+    alignas(64) atomic<size_t> L{0};   // 消费者写
+    size_t cachedR = 0;                // 消费者看到的 R
+    char pad[64 - sizeof(size_t)];
 };
 
-int main() {
+// 把当前线程绑到指定 CPU，不支持时什么也不做
+void pinThread(int cpu) {
+#ifdef __linux__
+    int n = (int)thread::hardware_concurrency();
+    if (n <= 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % n, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// 吞吐量：生产者按 batch 个一组放入 ops 个数，消费者按 batch 个一组取出并校验顺序
+void benchmarkThroughput(long long ops, size_t batch, size_t capacity) {
+    SpscDeque<long long> q(capacity);
+    atomic<bool> ok(true);
+    auto t0 = chrono::steady_clock::now();
+    thread consumer([&] {
+        pinThread(1);
+        vector<long long> buf(batch);
+        long long expect = 0;
+        while (expect < ops) {
+            size_t got = q.DeleteLeft(buf.data(), batch);
+            for (size_t i = 0; i < got; ++i) {
+                if (buf[i] != expect++) ok = false;
+            }
+            if (!got) this_thread::yield();
+        }
+    });
+    pinThread(0);
+    vector<long long> buf(batch);
+    for (long long next = 0; next < ops;) {
+        size_t n = (size_t)min<long long>((long long)batch, ops - next);
+        for (size_t i = 0; i < n; ++i) buf[i] = next + (long long)i;
+        size_t put = q.AddRight(buf.data(), n);
+        next += (long long)put;
+        if (!put) this_thread::yield();
+    }
+    consumer.join();
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "throughput batch=" << batch << ": " << fixed << setprecision(1) << ops / sec / 1e6 << " Mops/s"
+         << (ok ? "" : " (ORDER MISMATCH)") << '\n';
+}
+
+// 延迟：两个队列来回传递一个数（ping-pong），单程延迟取往返时间的一半
+void benchmarkLatency(int rounds) {
+    SpscDeque<int> ping(64), pong(64);
+    thread echo([&] {
+        pinThread(1);
+        for (int i = 0; i < rounds; ++i) {
+            int x;
+            while (!ping.DeleteLeft(x)) this_thread::yield();
+            while (!pong.AddRight(x)) this_thread::yield();
+        }
+    });
+    pinThread(0);
+    vector<double> ns(rounds);
+    for (int i = 0; i < rounds; ++i) {
+        auto t0 = chrono::steady_clock::now();
+        while (!ping.AddRight(i)) this_thread::yield();
+        int x;
+        while (!pong.DeleteLeft(x)) this_thread::yield();
+        ns[i] = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / 2;
+    }
+    echo.join();
+    sort(ns.begin(), ns.end());
+    cout << "one-way latency: p50 " << fixed << setprecision(0) << ns[rounds / 2] << " ns, p99 "
+         << ns[min(rounds - 1, rounds * 99 / 100)] << " ns\n";
+}
+
+// 用法：deque [limit]，limit 为容量上限（默认 MAXN，0 表示不限容量）
+//       deque bench [ops] [capacity]，测试 SpscDeque 的吞吐量与延迟
+int main(int argc, char* argv[]) {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
+    if (argc > 1 && string(argv[1]) == "bench") {
+        long long ops = argc > 2 ? atoll(argv[2]) : 10000000;
+        long long capacity = argc > 3 ? atoll(argv[3]) : 1024;
+        if (ops <= 0 || capacity <= 0) {
+            cout << "WRONG\n";
+            return 0;
+        }
+        for (size_t batch : {1, 16, 256}) {
+            if (batch > (size_t)capacity) break;
+            benchmarkThroughput(ops, batch, (size_t)capacity);
+        }
+        benchmarkLatency(100000);
+        return 0;
+    }
+
     ifstream fin("input.txt");
     if (!fin) {
         cerr << "无法打开 input.txt\n";
         return 0;
     }
 
-    Deque dq;
+    long long limit = argc > 1 ? atoll(argv[1]) : MAXN;
+    if (limit < 0) {
+        cout << "WRONG\n";
+        return 0;
+    }
+
+    Deque<int> dq((size_t)limit);
     string op;
     while (fin >> op) {
         if (op == "End") break;